@@ -0,0 +1,160 @@
+/**
+ * Reed-Solomon Benchmarks
+ *
+ * Times the table based encoder and syndrome calculator against the batch engines on the same
+ * random codewords and checks that every engine produces identical output.
+ */
+#include "galois.h"
+#include "rs_bitslice.h"
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_framesync.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_CODEWORDS 4096
+#define BENCH_STREAM_LEN 16384
+
+/**
+ * @brief Returns a monotonic timestamp in seconds
+ */
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Prints one benchmark line in codewords per second and MB/s of codeword data
+ * @param name Name of the engine
+ * @param seconds Elapsed time for BENCH_CODEWORDS codewords
+ * @param reference Elapsed time of the table path used for the speedup column
+ */
+static void report(const char *name, double seconds, double reference) {
+    double codewords_per_second = BENCH_CODEWORDS / seconds;
+    printf("%-28s %12.0f cw/s %10.2f MB/s %8.2fx\n", name, codewords_per_second,
+           codewords_per_second * FIELD_SIZE / 1e6, reference / seconds);
+}
+
+int main() {
+    initialise_gf();
+
+    int info_len = FIELD_SIZE - NUM_SYNDROMES;
+    uint8_t *info = malloc(BENCH_CODEWORDS * info_len * sizeof(uint8_t));
+    uint8_t *table_encoded = malloc(BENCH_CODEWORDS * FIELD_SIZE * sizeof(uint8_t));
+    uint8_t *batch_encoded = malloc(BENCH_CODEWORDS * FIELD_SIZE * sizeof(uint8_t));
+    uint8_t *table_syndromes = malloc(BENCH_CODEWORDS * NUM_SYNDROMES * sizeof(uint8_t));
+    uint8_t *batch_syndromes = malloc(BENCH_CODEWORDS * NUM_SYNDROMES * sizeof(uint8_t));
+
+    srand(1);
+    for (int i = 0; i < BENCH_CODEWORDS * info_len; i++) {
+        info[i] = rand() & 0xFF;
+    }
+
+    printf("Benchmarking %d codewords\n\n", BENCH_CODEWORDS);
+    printf("Encoding\n");
+
+    double start = now_seconds();
+    for (int i = 0; i < BENCH_CODEWORDS; i++) {
+        uint8_t *encoded_message = rs_encode(info + i * info_len, info_len);
+        memcpy(table_encoded + i * FIELD_SIZE, encoded_message, FIELD_SIZE * sizeof(uint8_t));
+        free(encoded_message);
+    }
+    double table_time = now_seconds() - start;
+    report("table (rs_encode)", table_time, table_time);
+
+    start = now_seconds();
+    bitslice_encode_batch(info, batch_encoded, BENCH_CODEWORDS);
+    report("bit-sliced", now_seconds() - start, table_time);
+
+    if (memcmp(table_encoded, batch_encoded, BENCH_CODEWORDS * FIELD_SIZE) != 0) {
+        printf("ERROR: bit-sliced encoder output differs from rs_encode\n");
+        return 1;
+    }
+
+    // Corrupt a few symbols so the syndromes are not all zero
+    for (int i = 0; i < BENCH_CODEWORDS; i++) {
+        table_encoded[i * FIELD_SIZE + rand() % FIELD_SIZE] ^= 1 + rand() % 255;
+    }
+
+    printf("\nSyndromes\n");
+
+    start = now_seconds();
+    for (int i = 0; i < BENCH_CODEWORDS; i++) {
+        compute_syndromes_horner(table_encoded + i * FIELD_SIZE, FIELD_SIZE,
+                                 table_syndromes + i * NUM_SYNDROMES);
+    }
+    table_time = now_seconds() - start;
+    report("table (Horner)", table_time, table_time);
+
+    start = now_seconds();
+    bitslice_syndromes_batch(table_encoded, batch_syndromes, BENCH_CODEWORDS);
+    report("bit-sliced", now_seconds() - start, table_time);
+
+    if (memcmp(table_syndromes, batch_syndromes, BENCH_CODEWORDS * NUM_SYNDROMES) != 0) {
+        printf("ERROR: bit-sliced syndromes differ from compute_syndromes\n");
+        return 1;
+    }
+
+    start = now_seconds();
+    for (int i = 0; i < BENCH_CODEWORDS; i++) {
+        compute_syndromes_minimal_poly(table_encoded + i * FIELD_SIZE, FIELD_SIZE,
+                                       batch_syndromes + i * NUM_SYNDROMES);
+    }
+    report("minimal polynomial", now_seconds() - start, table_time);
+
+    if (memcmp(table_syndromes, batch_syndromes, BENCH_CODEWORDS * NUM_SYNDROMES) != 0) {
+        printf("ERROR: minimal polynomial syndromes differ from compute_syndromes\n");
+        return 1;
+    }
+
+    printf("\nFrame synchronisation (%d byte stream)\n", BENCH_STREAM_LEN);
+
+    uint8_t *stream = malloc(BENCH_STREAM_LEN * sizeof(uint8_t));
+    for (int i = 0; i < BENCH_STREAM_LEN; i++) {
+        stream[i] = rand() & 0xFF;
+    }
+    memcpy(stream + BENCH_STREAM_LEN / 2, batch_encoded, FIELD_SIZE * sizeof(uint8_t));
+    int num_offsets = BENCH_STREAM_LEN - FIELD_SIZE + 1;
+
+    start = now_seconds();
+    int full_hits = 0;
+    for (int offset = 0; offset < num_offsets; offset++) {
+        if (!compute_syndromes_horner(stream + offset, FIELD_SIZE, table_syndromes)) full_hits++;
+    }
+    table_time = (now_seconds() - start) * BENCH_CODEWORDS / num_offsets;
+    report("recompute per offset", table_time, table_time);
+
+    frame_sync *sync = frame_sync_create();
+    frame_sync_hit hits[16];
+    start = now_seconds();
+    int sliding_hits = frame_sync_scan(sync, stream, BENCH_STREAM_LEN, hits, 16);
+    report("sliding window", (now_seconds() - start) * BENCH_CODEWORDS / num_offsets, table_time);
+    frame_sync_free(sync);
+
+    // The offsets next to the codeword are also found as correctable, since RS codes are cyclic
+    int clean_hits = 0;
+    for (int i = 0; i < sliding_hits; i++) {
+        if (hits[i].status == FRAME_SYNC_CLEAN && hits[i].offset == BENCH_STREAM_LEN / 2) {
+            clean_hits++;
+        }
+    }
+
+    if (full_hits != 1 || clean_hits != 1) {
+        printf("ERROR: frame synchronisation did not find the embedded codeword\n");
+        return 1;
+    }
+    free(stream);
+
+    free(info);
+    free(table_encoded);
+    free(batch_encoded);
+    free(table_syndromes);
+    free(batch_syndromes);
+    free(global_tables.antilog_table);
+    free(global_tables.log_table);
+    return 0;
+}
@@ -8,6 +8,13 @@ const int MAX_ERRORS = 16;
 const int NUM_SYNDROMES = 2 * MAX_ERRORS;
 log_tables global_tables;
 
+// quadratic_roots[c] holds a root y of y^2 + y = c, valid only where quadratic_solvable[c] is set
+static uint8_t quadratic_roots[256];
+static uint8_t quadratic_solvable[256];
+
+// minimal_polys[x] holds the minimal polynomial of x over GF(2), bit k is the coefficient of x^k
+static uint16_t minimal_polys[256];
+
 /**
  * @brief Creates log and antilog tables for the galois field GF(256) using primitive polynomial
  * @return Returns struct log_tables with log and antilog tables
@@ -40,7 +47,68 @@ log_tables init_gf_tables() {
 /**
  * @brief Initialises log and antilog tables
  */
-void initialise_gf() { global_tables = init_gf_tables(); }
+void initialise_gf() {
+    global_tables = init_gf_tables();
+    init_quadratic_table();
+    init_minimal_poly_table();
+}
+
+/**
+ * @brief Fills the lookup table used to solve y^2 + y = c in GF(256)
+ */
+void init_quadratic_table() {
+    for (int y = 0; y < 256; y++) {
+        uint8_t c = gf_add(gf_mult((uint8_t)y, (uint8_t)y), (uint8_t)y);
+        quadratic_roots[c] = (uint8_t)y;
+        quadratic_solvable[c] = 1;
+    }
+}
+
+/**
+ * @brief Solves y^2 + y = c in GF(256) using a lookup table
+ * @param c Constant term of the equation
+ * @param root Output parameter for one root, the other root is root + 1
+ * @return 1 if the equation has roots in GF(256), 0 otherwise
+ */
+int gf_quadratic_root(uint8_t c, uint8_t *root) {
+    if (!quadratic_solvable[c]) return 0;
+    *root = quadratic_roots[c];
+    return 1;
+}
+
+/**
+ * @brief Fills the table of minimal polynomials over GF(2) for every element of GF(256)
+ */
+void init_minimal_poly_table() {
+    for (int x = 0; x < 256; x++) {
+        // Multiply together (X + c) for every conjugate c = x^(2^k) of x
+        uint8_t poly[9] = {1};
+        int degree = 0;
+        uint8_t conjugate = (uint8_t)x;
+        do {
+            for (int k = degree + 1; k > 0; k--) {
+                poly[k] = gf_add(poly[k - 1], gf_mult(poly[k], conjugate));
+            }
+            poly[0] = gf_mult(poly[0], conjugate);
+            degree++;
+            conjugate = gf_mult(conjugate, conjugate);
+        } while (conjugate != x);
+
+        // The coefficients of a minimal polynomial are always 0 or 1
+        uint16_t packed = 0;
+        for (int k = 0; k <= degree; k++) {
+            if (poly[k]) packed |= 1 << k;
+        }
+        minimal_polys[x] = packed;
+    }
+}
+
+/**
+ * @brief Looks up the minimal polynomial of an element over GF(2)
+ * @param x Element of GF(256)
+ * @return Binary polynomial where bit k is the coefficient of x^k
+ */
+uint16_t gf_minimal_poly(uint8_t x) { return minimal_polys[x]; }
 
 /**
  * @brief adds two numbers together in Galois field using bitwise XOR
@@ -23,11 +23,15 @@ extern log_tables global_tables;
 // non-poly gf
 log_tables init_gf_tables();
 void initialise_gf();
+void init_quadratic_table();
+void init_minimal_poly_table();
 uint8_t gf_add(uint8_t a, uint8_t b);
 uint8_t gf_mult(uint8_t a, uint8_t b);
 uint8_t gf_div(uint8_t a, uint8_t b);
 uint8_t gf_pow(uint8_t base, uint8_t exponent);
 uint8_t gf_inv(uint8_t x);
+int gf_quadratic_root(uint8_t c, uint8_t *root);
+uint16_t gf_minimal_poly(uint8_t x);
 int gf_deg(uint8_t poly);
 uint8_t *gf_diff(uint8_t *poly, int poly_len);
 uint8_t gf_poly_eval(const uint8_t *poly, int degree, uint8_t x, int len);
@@ -0,0 +1,228 @@
+/**
+ * Bit-sliced Reed-Solomon Engine
+ *
+ * Batch encoder and syndrome calculator that processes BITSLICE_LANES codewords at once. Every
+ * symbol position of the batch is transposed into 8 bit-planes, where plane b holds bit b of that
+ * symbol for every codeword. Addition in GF(256) is then a XOR of planes, and multiplication by a
+ * constant c is linear over GF(2), so it is an 8x8 bit matrix applied to the planes. The matrices
+ * of the generator coefficients and of alpha^1..alpha^32 are built once per batch, and the inner
+ * loops only AND and XOR planes with them. No table lookups are performed per symbol.
+ *
+ * Memory Layout:
+ *  info: num_codewords consecutive messages of 223 symbols
+ *  encoded / received: num_codewords consecutive codewords of 255 symbols, same layout as rs_encode
+ *  syndromes: num_codewords consecutive blocks of NUM_SYNDROMES symbols, same order as
+ *             compute_syndromes (S_i at index NUM_SYNDROMES - i)
+ */
+#include "rs_bitslice.h"
+#include "galois.h"
+#include "rs_encoder.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Transposes an 8x8 bit matrix stored one row per byte
+ * @param x Matrix where byte i is row i
+ * @return Transposed matrix, bit j of byte i becomes bit i of byte j
+ */
+static uint64_t transpose8(uint64_t x) {
+    uint64_t t;
+    t = (x ^ (x >> 7)) & 0x00AA00AA00AA00AAULL;
+    x = x ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC0000CCCCULL;
+    x = x ^ t ^ (t << 14);
+    t = (x ^ (x >> 28)) & 0x00000000F0F0F0F0ULL;
+    x = x ^ t ^ (t << 28);
+    return x;
+}
+
+/**
+ * @brief Gathers one symbol position of a batch into 8 bit-planes
+ * @param data First codeword of the batch
+ * @param stride Distance in bytes between consecutive codewords
+ * @param lanes Number of codewords in the batch, at most BITSLICE_LANES
+ * @param planes Output bit-planes
+ */
+static void slice_symbol(const uint8_t *data, int stride, int lanes, bitslice_word planes[8]) {
+    memset(planes, 0, 8 * sizeof(bitslice_word));
+
+    for (int group = 0; group * 8 < lanes; group++) {
+        uint64_t rows = 0;
+        for (int i = 0; i < 8 && group * 8 + i < lanes; i++) {
+            rows |= (uint64_t)data[(group * 8 + i) * stride] << (8 * i);
+        }
+
+        uint64_t columns = transpose8(rows);
+        for (int b = 0; b < 8; b++) {
+            planes[b] |= ((columns >> (8 * b)) & 0xFF) << (8 * group);
+        }
+    }
+}
+
+/**
+ * @brief Scatters 8 bit-planes back into one symbol position of a batch
+ * @param planes Bit-planes to scatter
+ * @param data First codeword of the batch
+ * @param stride Distance in bytes between consecutive codewords
+ * @param lanes Number of codewords in the batch, at most BITSLICE_LANES
+ */
+static void unslice_symbol(const bitslice_word planes[8], uint8_t *data, int stride, int lanes) {
+    for (int group = 0; group * 8 < lanes; group++) {
+        uint64_t columns = 0;
+        for (int b = 0; b < 8; b++) {
+            columns |= ((planes[b] >> (8 * group)) & 0xFF) << (8 * b);
+        }
+
+        uint64_t rows = transpose8(columns);
+        for (int i = 0; i < 8 && group * 8 + i < lanes; i++) {
+            data[(group * 8 + i) * stride] = (rows >> (8 * i)) & 0xFF;
+        }
+    }
+}
+
+/**
+ * @brief Builds the bit matrix of multiplication by a constant. Column k is c * 2^k, so output
+ * plane b is the XOR of the input planes k whose product c * 2^k has bit b set.
+ * @param c Constant multiplier
+ * @param matrix Output, matrix[b][k] is all ones if input plane k feeds output plane b, else 0
+ */
+static void slice_const_matrix(uint8_t c, bitslice_word matrix[8][8]) {
+    for (int k = 0; k < 8; k++) {
+        uint8_t column = gf_mult(c, (uint8_t)(1 << k));
+        for (int b = 0; b < 8; b++) {
+            matrix[b][k] = ((column >> b) & 1) ? ~(bitslice_word)0 : 0;
+        }
+    }
+}
+
+/**
+ * @brief Adds c * x to an accumulator as a fixed network of plane ANDs and XORs
+ * @param matrix Output of slice_const_matrix for c
+ * @param x Bit-planes to multiply
+ * @param acc Bit-planes the product is added to
+ */
+static void slice_mult_add(const bitslice_word matrix[8][8], const bitslice_word x[8],
+                           bitslice_word acc[8]) {
+    for (int b = 0; b < 8; b++) {
+        bitslice_word sum = acc[b];
+        for (int k = 0; k < 8; k++) {
+            sum ^= x[k] & matrix[b][k];
+        }
+        acc[b] = sum;
+    }
+}
+
+/**
+ * @brief Encodes up to BITSLICE_LANES messages with a bit-sliced LFSR division by the generator
+ * @param info Messages to encode, 223 symbols each
+ * @param encoded Output codewords, 255 symbols each
+ * @param lanes Number of messages in the batch
+ * @param generator_matrices Multiplication matrices of the monic generator coefficients
+ */
+static void encode_lanes(const uint8_t *info, uint8_t *encoded, int lanes,
+                         const bitslice_word generator_matrices[NUM_SYNDROMES][8][8]) {
+    int info_len = FIELD_SIZE - NUM_SYNDROMES;
+    bitslice_word remainder[NUM_SYNDROMES][8];
+    bitslice_word feedback[8];
+
+    memset(remainder, 0, sizeof(remainder));
+
+    // Highest degree coefficient first, info symbol k is the coefficient of x^(k + NUM_SYNDROMES)
+    for (int k = info_len - 1; k >= 0; k--) {
+        slice_symbol(info + k, info_len, lanes, feedback);
+        for (int b = 0; b < 8; b++) {
+            feedback[b] ^= remainder[NUM_SYNDROMES - 1][b];
+        }
+
+        for (int t = NUM_SYNDROMES - 1; t > 0; t--) {
+            memcpy(remainder[t], remainder[t - 1], 8 * sizeof(bitslice_word));
+            slice_mult_add(generator_matrices[t], feedback, remainder[t]);
+        }
+        memset(remainder[0], 0, 8 * sizeof(bitslice_word));
+        slice_mult_add(generator_matrices[0], feedback, remainder[0]);
+    }
+
+    for (int t = 0; t < NUM_SYNDROMES; t++) {
+        unslice_symbol(remainder[t], encoded + t, FIELD_SIZE, lanes);
+    }
+    for (int lane = 0; lane < lanes; lane++) {
+        memcpy(encoded + lane * FIELD_SIZE + NUM_SYNDROMES, info + lane * info_len,
+               info_len * sizeof(uint8_t));
+    }
+}
+
+/**
+ * @brief Encodes a batch of messages, producing the same codewords as rs_encode
+ * @param info num_codewords consecutive messages of 223 symbols
+ * @param encoded Output buffer for num_codewords consecutive codewords of 255 symbols
+ * @param num_codewords Number of messages to encode
+ */
+void bitslice_encode_batch(const uint8_t *info, uint8_t *encoded, int num_codewords) {
+    int info_len = FIELD_SIZE - NUM_SYNDROMES;
+    uint8_t monic_generator[NUM_SYNDROMES];
+    bitslice_word generator_matrices[NUM_SYNDROMES][8][8];
+    calculate_monic_generator(monic_generator);
+    for (int t = 0; t < NUM_SYNDROMES; t++) {
+        slice_const_matrix(monic_generator[t], generator_matrices[t]);
+    }
+
+    for (int first = 0; first < num_codewords; first += BITSLICE_LANES) {
+        int lanes = num_codewords - first;
+        if (lanes > BITSLICE_LANES) lanes = BITSLICE_LANES;
+
+        encode_lanes(info + first * info_len, encoded + first * FIELD_SIZE, lanes,
+                     generator_matrices);
+    }
+}
+
+/**
+ * @brief Calculates the syndromes of up to BITSLICE_LANES codewords with bit-sliced Horner loops
+ * @param received Received codewords, 255 symbols each
+ * @param syndromes Output syndromes, NUM_SYNDROMES symbols per codeword
+ * @param lanes Number of codewords in the batch
+ * @param alpha_matrices Multiplication matrices of alpha^1..alpha^NUM_SYNDROMES
+ */
+static void syndromes_lanes(const uint8_t *received, uint8_t *syndromes, int lanes,
+                            const bitslice_word alpha_matrices[NUM_SYNDROMES][8][8]) {
+    bitslice_word symbols[255][8];
+    bitslice_word result[8];
+    bitslice_word next[8];
+
+    for (int j = 0; j < FIELD_SIZE; j++) {
+        slice_symbol(received + j, FIELD_SIZE, lanes, symbols[j]);
+    }
+
+    for (int i = 0; i < NUM_SYNDROMES; i++) {
+        memcpy(result, symbols[0], sizeof(result));
+
+        for (int j = 1; j < FIELD_SIZE; j++) {
+            memcpy(next, symbols[j], sizeof(next));
+            slice_mult_add(alpha_matrices[i], result, next);
+            memcpy(result, next, sizeof(result));
+        }
+
+        unslice_symbol(result, syndromes + NUM_SYNDROMES - 1 - i, NUM_SYNDROMES, lanes);
+    }
+}
+
+/**
+ * @brief Calculates the syndromes of a batch of codewords, matching compute_syndromes
+ * @param received num_codewords consecutive codewords of 255 symbols
+ * @param syndromes Output buffer for num_codewords blocks of NUM_SYNDROMES syndromes
+ * @param num_codewords Number of codewords
+ */
+void bitslice_syndromes_batch(const uint8_t *received, uint8_t *syndromes, int num_codewords) {
+    bitslice_word alpha_matrices[NUM_SYNDROMES][8][8];
+    for (int i = 0; i < NUM_SYNDROMES; i++) {
+        slice_const_matrix(gf_pow(2, i + 1), alpha_matrices[i]);
+    }
+
+    for (int first = 0; first < num_codewords; first += BITSLICE_LANES) {
+        int lanes = num_codewords - first;
+        if (lanes > BITSLICE_LANES) lanes = BITSLICE_LANES;
+
+        syndromes_lanes(received + first * FIELD_SIZE, syndromes + first * NUM_SYNDROMES, lanes,
+                        alpha_matrices);
+    }
+}
@@ -0,0 +1,17 @@
+#ifndef RS_BITSLICE_H
+#define RS_BITSLICE_H
+
+#include "galois.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+// One bit-plane word, each bit belongs to a different codeword
+typedef uint64_t bitslice_word;
+
+// Number of codewords processed together by one pass of the bit-sliced engine
+#define BITSLICE_LANES 64
+
+void bitslice_encode_batch(const uint8_t *info, uint8_t *encoded, int num_codewords);
+void bitslice_syndromes_batch(const uint8_t *received, uint8_t *syndromes, int num_codewords);
+
+#endif // RS_BITSLICE_H
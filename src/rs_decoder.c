@@ -16,26 +16,54 @@
  */
 #include "rs_decoder.h"
 #include "galois.h"
+#include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+static syndrome_engine active_syndrome_engine = SYNDROME_HORNER;
+static int decoder_verbose = 1;
+
 /**
- * @brief Calculates the syndrome polynomial using equation 11.1 from referenced book
+ * @brief Enables or disables the progress output of the decoder
+ * @param verbose 1 to print decoding steps (default), 0 to decode silently
+ */
+void set_decoder_verbose(int verbose) { decoder_verbose = verbose; }
+
+/**
+ * @brief printf that only prints when the decoder is verbose
+ * @param format printf format string
+ */
+void decoder_log(const char *format, ...) {
+    if (!decoder_verbose) return;
+
+    va_list args;
+    va_start(args, format);
+    vprintf(format, args);
+    va_end(args);
+}
+
+/**
+ * @brief Selects the algorithm used by compute_syndromes and find_syndromes
+ * @param engine SYNDROME_HORNER or SYNDROME_MINIMAL_POLY
+ */
+void set_syndrome_engine(syndrome_engine engine) { active_syndrome_engine = engine; }
+
+/**
+ * @brief Calculates the syndromes using equation 11.1 from referenced book with one Horner loop per
+ * syndrome
  * @param received_poly Polynomial representing the received encoded message
  * @param codeword_length Length of received_poly
- * @param alpha Primitive element in GF(256)
- * @return Syndrome polynomial for the received encoded message, or NULL if no errors are detected
+ * @param syndrome_output Output array of at least NUM_SYNDROMES symbols, S_i is stored at index
+ * NUM_SYNDROMES - i
+ * @return 1 if any syndrome is non-zero, 0 otherwise
  */
-uint8_t *find_syndromes(uint8_t *received_poly, int codeword_length) {
+int compute_syndromes_horner(const uint8_t *received_poly, int codeword_length,
+                             uint8_t *syndrome_output) {
     uint8_t alpha = 2;
-    // +1 is important so that syndrome is the correct length for extended_euclidean_algorithm
-    uint8_t *syndrome_output = calloc(NUM_SYNDROMES + 1, sizeof(uint8_t));
     int errors_detected = 0;
 
-    printf("Calculating %d syndromes...\n", NUM_SYNDROMES);
-
     for (int i = 0; i < NUM_SYNDROMES; i++) {
         uint8_t alpha_i = gf_pow(alpha, i + 1);
         uint8_t result = received_poly[0];
@@ -52,14 +80,124 @@ uint8_t *find_syndromes(uint8_t *received_poly, int codeword_length) {
         }
     }
 
-    printf("Syndromes: ");
+    return errors_detected;
+}
+
+/**
+ * @brief Calculates the syndromes by first reducing the received polynomial modulo the minimal
+ * polynomial of each alpha^i. The minimal polynomials are binary, so the reduction only needs
+ * XORs, and alpha^1..alpha^32 share 16 of them. Each syndrome is then the remainder (degree < 8)
+ * evaluated at alpha^i.
+ * @param received_poly Polynomial representing the received encoded message, received_poly[0] is
+ * the highest degree coefficient
+ * @param codeword_length Length of received_poly, lengths above FIELD_SIZE fall back to
+ * compute_syndromes_horner
+ * @param syndrome_output Output array of at least NUM_SYNDROMES symbols, S_i is stored at index
+ * NUM_SYNDROMES - i
+ * @return 1 if any syndrome is non-zero, 0 otherwise
+ */
+int compute_syndromes_minimal_poly(const uint8_t *received_poly, int codeword_length,
+                                   uint8_t *syndrome_output) {
+    uint8_t alpha = 2;
+    int errors_detected = 0;
+    uint16_t reduced_polys[NUM_SYNDROMES];
+    uint8_t remainders[NUM_SYNDROMES][8];
+    int num_reduced = 0;
+    uint8_t work[FIELD_SIZE];
+
+    // The reduction works on a fixed size copy, longer inputs take the Horner path instead
+    if (codeword_length > FIELD_SIZE) {
+        return compute_syndromes_horner(received_poly, codeword_length, syndrome_output);
+    }
+
+    for (int i = 0; i < NUM_SYNDROMES; i++) {
+        uint8_t alpha_i = gf_pow(alpha, i + 1);
+        uint16_t minimal_poly = gf_minimal_poly(alpha_i);
+        int degree = 8;
+        while (!((minimal_poly >> degree) & 1)) {
+            degree--;
+        }
+
+        int cached = 0;
+        while (cached < num_reduced && reduced_polys[cached] != minimal_poly) {
+            cached++;
+        }
+
+        if (cached == num_reduced) {
+            // Taps are the distances from the leading term to the other non-zero terms
+            int taps[8];
+            int num_taps = 0;
+            for (int t = 0; t < degree; t++) {
+                if ((minimal_poly >> t) & 1) taps[num_taps++] = degree - t;
+            }
+
+            memcpy(work, received_poly, codeword_length * sizeof(uint8_t));
+            for (int j = 0; j + degree < codeword_length; j++) {
+                uint8_t coeff = work[j];
+                for (int k = 0; k < num_taps; k++) {
+                    work[j + taps[k]] ^= coeff;
+                }
+            }
+
+            memset(remainders[num_reduced], 0, sizeof(remainders[num_reduced]));
+            int remainder_len = degree < codeword_length ? degree : codeword_length;
+            memcpy(remainders[num_reduced] + degree - remainder_len,
+                   work + codeword_length - remainder_len, remainder_len * sizeof(uint8_t));
+            reduced_polys[num_reduced++] = minimal_poly;
+        }
+
+        uint8_t result = remainders[cached][0];
+        for (int j = 1; j < degree; j++) {
+            result = gf_add(remainders[cached][j], gf_mult(result, alpha_i));
+        }
+
+        syndrome_output[NUM_SYNDROMES - 1 - i] = result;
+
+        if (result != 0) {
+            errors_detected = 1;
+        }
+    }
+
+    return errors_detected;
+}
+
+/**
+ * @brief Calculates the syndromes with the engine chosen by set_syndrome_engine, without any output
+ * @param received_poly Polynomial representing the received encoded message
+ * @param codeword_length Length of received_poly
+ * @param syndrome_output Output array of at least NUM_SYNDROMES symbols, S_i is stored at index
+ * NUM_SYNDROMES - i
+ * @return 1 if any syndrome is non-zero, 0 otherwise
+ */
+int compute_syndromes(const uint8_t *received_poly, int codeword_length, uint8_t *syndrome_output) {
+    if (active_syndrome_engine == SYNDROME_MINIMAL_POLY) {
+        return compute_syndromes_minimal_poly(received_poly, codeword_length, syndrome_output);
+    }
+    return compute_syndromes_horner(received_poly, codeword_length, syndrome_output);
+}
+
+/**
+ * @brief Calculates the syndrome polynomial using equation 11.1 from referenced book
+ * @param received_poly Polynomial representing the received encoded message
+ * @param codeword_length Length of received_poly
+ * @return Syndrome polynomial for the received encoded message, or NULL if no errors are detected
+ */
+uint8_t *find_syndromes(uint8_t *received_poly, int codeword_length) {
+    // +1 is important so that syndrome is the correct length for extended_euclidean_algorithm
+    uint8_t *syndrome_output = calloc(NUM_SYNDROMES + 1, sizeof(uint8_t));
+
+    decoder_log("Calculating %d syndromes...\n", NUM_SYNDROMES);
+
+    int errors_detected = compute_syndromes(received_poly, codeword_length, syndrome_output);
+
+    decoder_log("Syndromes: ");
     for (int i = 0; i < NUM_SYNDROMES; i++) {
-        printf("%d ", syndrome_output[i]);
+        decoder_log("%d ", syndrome_output[i]);
     }
-    printf("\n");
+    decoder_log("\n");
 
     if (!errors_detected) {
-        printf("No errors detected - all syndromes are zero\n");
+        decoder_log("No errors detected - all syndromes are zero\n");
         free(syndrome_output);
         return NULL;
     }
@@ -76,8 +214,8 @@ uint8_t *find_syndromes(uint8_t *received_poly, int codeword_length) {
  * lengths
  */
 euclidean_result extended_euclidean_algorithm(uint8_t *syndrome_poly, int syndrome_poly_len) {
-    printf("\n--- Extended Euclidean Algorithm ---\n");
-    printf("Parameters: syndrome_len=%d, max_errors=%d\n", syndrome_poly_len, MAX_ERRORS);
+    decoder_log("\n--- Extended Euclidean Algorithm ---\n");
+    decoder_log("Parameters: syndrome_len=%d, max_errors=%d\n", syndrome_poly_len, MAX_ERRORS);
 
     int poly_size = syndrome_poly_len + 1;
 
@@ -127,20 +265,22 @@ euclidean_result extended_euclidean_algorithm(uint8_t *syndrome_poly, int syndro
         iteration++;
     }
 
-    printf("\nFinal Results:\n");
-    printf("Error Locator Polynomial (degree %d): ", poly_degree(current_bezout_coeff, poly_size));
+    decoder_log("\nFinal Results:\n");
+    decoder_log("Error Locator Polynomial (degree %d): ",
+                poly_degree(current_bezout_coeff, poly_size));
     for (int i = 0; i < 10 && i < poly_size; i++) {
-        printf("%d ", current_bezout_coeff[i]);
+        decoder_log("%d ", current_bezout_coeff[i]);
     }
-    if (poly_size > 10) printf("...");
-    printf("\n");
+    if (poly_size > 10) decoder_log("...");
+    decoder_log("\n");
 
-    printf("Error Evaluator Polynomial (degree %d): ", poly_degree(current_remainder, poly_size));
+    decoder_log("Error Evaluator Polynomial (degree %d): ",
+                poly_degree(current_remainder, poly_size));
     for (int i = 0; i < 10 && i < poly_size; i++) {
-        printf("%d ", current_remainder[i]);
+        decoder_log("%d ", current_remainder[i]);
     }
-    if (poly_size > 10) printf("...");
-    printf("\n");
+    if (poly_size > 10) decoder_log("...");
+    decoder_log("\n");
 
     if (prev_bezout_coeff != original_bezout_coeff &&
         prev_bezout_coeff != original_current_bezout_coeff) {
@@ -244,67 +384,348 @@ uint8_t *resolve_errors(uint8_t *error_vector, uint8_t *received_message, int me
 }
 
 /**
- * @brief Main Reed-Solomon decoding function that corrects errors in received message
- * @param encoded_message Received message potentially containing errors
- * @param message_len Length of the message
- * @return Decoded message with errors corrected
+ * @brief Returns syndrome S_i from a syndrome polynomial produced by find_syndromes
+ * @param syndrome_poly Syndrome polynomial, stored with S_1 at the highest index
+ * @param i Syndrome number, 1 to NUM_SYNDROMES
+ * @return The syndrome S_i
  */
-uint8_t *decode_message(uint8_t *encoded_message, int message_len) {
-    printf("Reed-Solomon Decoder - Message Length: %d, Max Errors: %d\n", message_len, MAX_ERRORS);
+static uint8_t syndrome_at(const uint8_t *syndrome_poly, int i) {
+    return syndrome_poly[NUM_SYNDROMES - i];
+}
 
-    uint8_t *syndrome_poly = find_syndromes(encoded_message, message_len);
-    if (!syndrome_poly) {
-        printf("Message is error-free\n");
-        uint8_t *clean_message = malloc(message_len * sizeof(uint8_t));
-        memcpy(clean_message, encoded_message, message_len);
-        return clean_message;
+/**
+ * @brief Checks that an error pattern reproduces every syndrome, S_i = sum Y_k * X_k^i
+ * @param syndrome_poly Syndrome polynomial for the received message
+ * @param locators Error locators X_k = alpha^(254 - position)
+ * @param values Error values Y_k
+ * @param error_amount Number of errors in the pattern
+ * @return 1 if all syndromes match, 0 otherwise
+ */
+static int error_pattern_matches(const uint8_t *syndrome_poly, const uint8_t *locators,
+                                 const uint8_t *values, int error_amount) {
+    uint8_t terms[2];
+    for (int k = 0; k < error_amount; k++) {
+        terms[k] = values[k];
+    }
+
+    for (int i = 1; i <= NUM_SYNDROMES; i++) {
+        uint8_t sum = 0;
+        for (int k = 0; k < error_amount; k++) {
+            terms[k] = gf_mult(terms[k], locators[k]);
+            sum = gf_add(sum, terms[k]);
+        }
+        if (sum != syndrome_at(syndrome_poly, i)) return 0;
+    }
+    return 1;
+}
+
+/**
+ * @brief Attempts to correct one or two errors directly from the syndromes using Peterson's
+ * closed-form solutions, skipping the Euclidean algorithm and the root search
+ * @param syndrome_poly Syndrome polynomial for the received message
+ * @param error_vector Output array of length message_len, error values are written at their
+ * positions
+ * @param message_len Length of the received message
+ * @return Number of errors corrected (1 or 2), or 0 if the syndromes do not match one or two errors
+ */
+int correct_few_errors(const uint8_t *syndrome_poly, uint8_t *error_vector, int message_len) {
+    uint8_t s1 = syndrome_at(syndrome_poly, 1);
+    uint8_t s2 = syndrome_at(syndrome_poly, 2);
+    uint8_t s3 = syndrome_at(syndrome_poly, 3);
+    uint8_t s4 = syndrome_at(syndrome_poly, 4);
+    uint8_t locators[2];
+    uint8_t values[2];
+    int error_amount = 0;
+
+    // One error: S_(i+1) = X * S_i, so X = S_2 / S_1 and Y = S_1 / X
+    if (s1 != 0 && s2 != 0) {
+        locators[0] = gf_div(s2, s1);
+        values[0] = gf_div(s1, locators[0]);
+        if (error_pattern_matches(syndrome_poly, locators, values, 1)) error_amount = 1;
+    }
+
+    // Two errors: solve the 2x2 Newton identities for the locator coefficients, then factor
+    // X^2 + sigma_1 X + sigma_2 by substituting X = sigma_1 y into y^2 + y = sigma_2 / sigma_1^2
+    if (error_amount == 0) {
+        uint8_t det = gf_add(gf_mult(s2, s2), gf_mult(s1, s3));
+        if (det == 0) return 0;
+
+        uint8_t sigma_1 = gf_div(gf_add(gf_mult(s2, s3), gf_mult(s1, s4)), det);
+        uint8_t sigma_2 = gf_div(gf_add(gf_mult(s3, s3), gf_mult(s2, s4)), det);
+        if (sigma_1 == 0 || sigma_2 == 0) return 0;
+
+        uint8_t y;
+        if (!gf_quadratic_root(gf_div(sigma_2, gf_mult(sigma_1, sigma_1)), &y)) return 0;
+
+        locators[0] = gf_mult(sigma_1, y);
+        locators[1] = gf_add(locators[0], sigma_1);
+        if (locators[0] == 0 || locators[1] == 0) return 0;
+
+        values[0] = gf_div(gf_add(gf_mult(s1, locators[1]), s2), gf_mult(locators[0], sigma_1));
+        values[1] = gf_div(gf_add(gf_mult(s1, locators[0]), s2), gf_mult(locators[1], sigma_1));
+        if (values[0] == 0 || values[1] == 0) return 0;
+
+        if (!error_pattern_matches(syndrome_poly, locators, values, 2)) return 0;
+        error_amount = 2;
+    }
+
+    for (int k = 0; k < error_amount; k++) {
+        int position = 254 - global_tables.log_table[locators[k]];
+        if (position >= message_len) return 0;
+    }
+
+    for (int k = 0; k < error_amount; k++) {
+        int position = 254 - global_tables.log_table[locators[k]];
+        error_vector[position] = values[k];
+    }
+
+    return error_amount;
+}
+
+/**
+ * @brief Finds the error positions and values for a received message from its syndromes
+ * @param syndromes NUM_SYNDROMES syndromes in the order produced by compute_syndromes
+ * @param error_vector Output array of length message_len, error values are written at their
+ * positions
+ * @param message_len Length of the received message
+ * @return Number of errors found, or -1 if the number of roots of the error locator polynomial does
+ * not match its degree, meaning there are more errors than can be corrected
+ */
+int locate_errors(const uint8_t *syndromes, uint8_t *error_vector, int message_len) {
+    int few_errors = correct_few_errors(syndromes, error_vector, message_len);
+    if (few_errors > 0) {
+        decoder_log("\nCorrected %d errors without the Euclidean algorithm\n", few_errors);
+        return few_errors;
     }
 
+    // poly_div inside extended_euclidean_algorithm reads one symbol past the syndromes
+    uint8_t *syndrome_poly = calloc(NUM_SYNDROMES + 1, sizeof(uint8_t));
+    memcpy(syndrome_poly, syndromes, NUM_SYNDROMES * sizeof(uint8_t));
+
     euclidean_result euclid_output = extended_euclidean_algorithm(syndrome_poly, NUM_SYNDROMES);
     uint8_t *error_evaluator_polynomial = euclid_output.error_evaluator_polynomial;
     uint8_t *error_locator_polynomial = euclid_output.error_locator_polynomial;
     int locator_len = euclid_output.locator_len;
     int evaluator_len = euclid_output.evaluator_len;
 
-    printf("\nFinding error positions...\n");
+    decoder_log("\nFinding error positions...\n");
     int num_roots = 0;
     uint8_t *error_positions =
         calculate_error_positions(error_locator_polynomial, locator_len, &num_roots);
-    printf("Found %d error roots\n", num_roots);
+    decoder_log("Found %d error roots\n", num_roots);
 
     uint8_t *error_values =
         calculate_error_values(error_positions, error_evaluator_polynomial,
                                error_locator_polynomial, num_roots, locator_len, evaluator_len);
 
-    uint8_t *error_vector = malloc(sizeof(uint8_t) * message_len);
-    memset(error_vector, 0, sizeof(uint8_t) * message_len);
-
-    printf("\nError Correction Summary:\n");
-    printf("Index | Root | Log  | Position | Error Value\n");
-    printf("------|------|------|----------|------------\n");
+    decoder_log("\nError Correction Summary:\n");
+    decoder_log("Index | Root | Log  | Position | Error Value\n");
+    decoder_log("------|------|------|----------|------------\n");
 
     for (int i = 0; i < num_roots; ++i) {
         uint8_t root = error_positions[i];
         int position = (254 - global_tables.log_table[root]) % message_len;
 
-        printf("%-5d | %-4d | %-4d | %-8d | %-11d\n", i, root, global_tables.log_table[root],
-               position, error_values[i]);
+        decoder_log("%-5d | %-4d | %-4d | %-8d | %-11d\n", i, root, global_tables.log_table[root],
+                    position, error_values[i]);
 
         if (position >= 0 && position < message_len) {
             error_vector[position] = error_values[i];
         }
     }
 
-    uint8_t *decoded_message = resolve_errors(error_vector, encoded_message, message_len);
-
-    printf("\nDecoding complete - corrected %d errors\n", num_roots);
+    int locator_degree = poly_degree(error_locator_polynomial, locator_len);
 
-    free(syndrome_poly);
     free(error_positions);
     free(error_values);
-    free(error_vector);
-    free(error_evaluator_polynomial);
+    // The Euclidean algorithm returns the syndrome polynomial itself when it needs no iterations
+    if (error_evaluator_polynomial != syndrome_poly) {
+        free(error_evaluator_polynomial);
+    }
     free(error_locator_polynomial);
+    free(syndrome_poly);
+
+    if (num_roots != locator_degree) {
+        decoder_log("Error locator has degree %d but %d roots - message is uncorrectable\n",
+                    locator_degree, num_roots);
+        return -1;
+    }
+
+    return num_roots;
+}
+
+/**
+ * @brief Finds the error and erasure values for a received message whose erased positions are
+ * known. The erasure locator Gamma(x) = prod (1 - X_k x) is folded into the syndromes to give the
+ * Forney syndromes T(x) = S(x) Gamma(x) mod x^32, and the Euclidean algorithm on (x^32, T(x)) is
+ * stopped once 2 deg Omega < NUM_SYNDROMES + e, so that up to (NUM_SYNDROMES - e) / 2 errors are
+ * found next to the e erasures. The values at the roots of Psi = Lambda Gamma then follow from
+ * Forney's formula Y = Omega(X^-1) / Psi'(X^-1).
+ * @param syndromes NUM_SYNDROMES syndromes in the order produced by compute_syndromes
+ * @param erasure_positions Indices of the erased symbols in the received message
+ * @param num_erasures Number of erased symbols, at most NUM_SYNDROMES
+ * @param error_vector Output array of length message_len, error values are written at their
+ * positions
+ * @param message_len Length of the received message, at most FIELD_SIZE
+ * @return Number of positions corrected, erasures included, or -1 if the message is uncorrectable
+ */
+int locate_errors_and_erasures(const uint8_t *syndromes, const int *erasure_positions,
+                               int num_erasures, uint8_t *error_vector, int message_len) {
+    int poly_size = NUM_SYNDROMES + 1;
+    uint8_t erasure_locator[NUM_SYNDROMES + 1];
+    uint8_t prev_remainder[NUM_SYNDROMES + 1];
+    uint8_t remainder[NUM_SYNDROMES + 1];
+    uint8_t prev_bezout_coeff[NUM_SYNDROMES + 1];
+    uint8_t bezout_coeff[NUM_SYNDROMES + 1];
+    uint8_t locator[NUM_SYNDROMES + 1];
+
+    if (num_erasures > NUM_SYNDROMES || message_len > FIELD_SIZE) return -1;
+
+    // Gamma(x) = prod (1 - X_k x), with X_k = alpha^degree for the symbol's degree in the codeword
+    memset(erasure_locator, 0, sizeof(erasure_locator));
+    erasure_locator[0] = 1;
+    for (int k = 0; k < num_erasures; k++) {
+        if (erasure_positions[k] < 0 || erasure_positions[k] >= message_len) return -1;
+        uint8_t x_k = gf_pow(2, (uint8_t)(message_len - 1 - erasure_positions[k]));
+        for (int j = k + 1; j > 0; j--) {
+            erasure_locator[j] = gf_add(erasure_locator[j], gf_mult(x_k, erasure_locator[j - 1]));
+        }
+    }
+
+    // T(x) = S(x) Gamma(x) mod x^32 with S(x) = S_1 + S_2 x + ... + S_32 x^31
+    memset(remainder, 0, sizeof(remainder));
+    for (int i = 0; i < NUM_SYNDROMES; i++) {
+        uint8_t s_i = syndrome_at(syndromes, i + 1);
+        if (s_i == 0) continue;
+        for (int j = 0; j <= num_erasures && i + j < NUM_SYNDROMES; j++) {
+            remainder[i + j] = gf_add(remainder[i + j], gf_mult(s_i, erasure_locator[j]));
+        }
+    }
+
+    memset(prev_remainder, 0, sizeof(prev_remainder));
+    prev_remainder[NUM_SYNDROMES] = 1;
+    memset(prev_bezout_coeff, 0, sizeof(prev_bezout_coeff));
+    memset(bezout_coeff, 0, sizeof(bezout_coeff));
+    bezout_coeff[0] = 1;
+
+    // Each step reduces the previous remainder by the current one in place, then swaps them
+    int remainder_degree = poly_degree(remainder, poly_size);
+    while (2 * remainder_degree >= NUM_SYNDROMES + num_erasures) {
+        int prev_degree = poly_degree(prev_remainder, poly_size);
+        while (prev_degree >= remainder_degree) {
+            int shift = prev_degree - remainder_degree;
+            uint8_t coeff = gf_div(prev_remainder[prev_degree], remainder[remainder_degree]);
+            for (int j = 0; j + shift < poly_size; j++) {
+                prev_remainder[j + shift] =
+                    gf_add(prev_remainder[j + shift], gf_mult(coeff, remainder[j]));
+                prev_bezout_coeff[j + shift] =
+                    gf_add(prev_bezout_coeff[j + shift], gf_mult(coeff, bezout_coeff[j]));
+            }
+            prev_degree = poly_degree(prev_remainder, poly_size);
+        }
+
+        uint8_t swap[NUM_SYNDROMES + 1];
+        memcpy(swap, prev_remainder, sizeof(swap));
+        memcpy(prev_remainder, remainder, sizeof(swap));
+        memcpy(remainder, swap, sizeof(swap));
+        memcpy(swap, prev_bezout_coeff, sizeof(swap));
+        memcpy(prev_bezout_coeff, bezout_coeff, sizeof(swap));
+        memcpy(bezout_coeff, swap, sizeof(swap));
+        remainder_degree = prev_degree;
+    }
+
+    // Psi(x) = Lambda(x) Gamma(x) locates errors and erasures together
+    int error_degree = poly_degree(bezout_coeff, poly_size);
+    if (2 * error_degree + num_erasures > NUM_SYNDROMES) {
+        decoder_log("%d errors and %d erasures exceed the correction capability\n", error_degree,
+                    num_erasures);
+        return -1;
+    }
+    memset(locator, 0, sizeof(locator));
+    for (int i = 0; i <= error_degree; i++) {
+        for (int j = 0; j <= num_erasures; j++) {
+            locator[i + j] = gf_add(locator[i + j], gf_mult(bezout_coeff[i], erasure_locator[j]));
+        }
+    }
+    int locator_degree = error_degree + num_erasures;
+
+    // Psi'(x) keeps the odd terms only in characteristic 2
+    uint8_t *locator_derivative = gf_diff(locator, poly_size);
+    int evaluator_degree = poly_degree(remainder, poly_size);
+    int derivative_degree = poly_degree(locator_derivative, poly_size - 1);
+
+    uint8_t found_values[NUM_SYNDROMES];
+    int found_positions[NUM_SYNDROMES];
+    int num_roots = 0;
+    for (int position = 0; position < message_len && num_roots <= locator_degree; position++) {
+        uint8_t x_inv = gf_inv(gf_pow(2, (uint8_t)(message_len - 1 - position)));
+        if (gf_poly_eval(locator, locator_degree, x_inv, poly_size) != 0) continue;
+        if (num_roots == locator_degree) {
+            num_roots++;
+            break;
+        }
+
+        uint8_t numerator = evaluator_degree < 0 ? 0
+                                                 : gf_poly_eval(remainder, evaluator_degree, x_inv,
+                                                                poly_size);
+        uint8_t denominator =
+            gf_poly_eval(locator_derivative, derivative_degree, x_inv, poly_size - 1);
+        if (denominator == 0) break;
+
+        found_positions[num_roots] = position;
+        found_values[num_roots] = gf_div(numerator, denominator);
+        num_roots++;
+    }
+    free(locator_derivative);
+
+    if (num_roots != locator_degree) {
+        decoder_log("Error and erasure locator has degree %d but %d roots - message is "
+                    "uncorrectable\n",
+                    locator_degree, num_roots);
+        return -1;
+    }
+
+    for (int k = 0; k < num_roots; k++) {
+        error_vector[found_positions[k]] = found_values[k];
+    }
+    return num_roots;
+}
+
+/**
+ * @brief Main Reed-Solomon decoding function that corrects errors in received message
+ * @param encoded_message Received message potentially containing errors
+ * @param message_len Length of the message
+ * @return Decoded message with errors corrected, or an unmodified copy of encoded_message if the
+ * errors cannot be corrected
+ */
+uint8_t *decode_message(uint8_t *encoded_message, int message_len) {
+    decoder_log("Reed-Solomon Decoder - Message Length: %d, Max Errors: %d\n", message_len,
+                MAX_ERRORS);
+
+    uint8_t *syndrome_poly = find_syndromes(encoded_message, message_len);
+    if (!syndrome_poly) {
+        decoder_log("Message is error-free\n");
+        uint8_t *clean_message = malloc(message_len * sizeof(uint8_t));
+        memcpy(clean_message, encoded_message, message_len);
+        return clean_message;
+    }
+
+    uint8_t *error_vector = calloc(message_len, sizeof(uint8_t));
+    int num_errors = locate_errors(syndrome_poly, error_vector, message_len);
+
+    uint8_t *decoded_message;
+    if (num_errors < 0) {
+        // Applying a partial error vector would return a wrong codeword, keep the received one
+        decoded_message = malloc(message_len * sizeof(uint8_t));
+        memcpy(decoded_message, encoded_message, message_len);
+        decoder_log("\nDecoding failed - too many errors to correct\n");
+    } else {
+        decoded_message = resolve_errors(error_vector, encoded_message, message_len);
+        decoder_log("\nDecoding complete - corrected %d errors\n", num_errors);
+    }
+
+    free(syndrome_poly);
+    free(error_vector);
 
     return decoded_message;
 }
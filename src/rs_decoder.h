@@ -14,13 +14,31 @@ typedef struct {
     int locator_len;
 } euclidean_result;
 
+// Algorithms available for syndrome computation
+typedef enum {
+    SYNDROME_HORNER,       // One Horner loop of table multiplications per syndrome
+    SYNDROME_MINIMAL_POLY, // XOR-only reduction modulo minimal polynomials, then short Horner loops
+} syndrome_engine;
+
 // Core Reed-Solomon decoding functions
+void set_decoder_verbose(int verbose);
+void decoder_log(const char *format, ...);
+void set_syndrome_engine(syndrome_engine engine);
+int compute_syndromes_horner(const uint8_t *received_poly, int codeword_length,
+                             uint8_t *syndrome_output);
+int compute_syndromes_minimal_poly(const uint8_t *received_poly, int codeword_length,
+                                   uint8_t *syndrome_output);
+int compute_syndromes(const uint8_t *received_poly, int codeword_length, uint8_t *syndrome_output);
 uint8_t *find_syndromes(uint8_t *received_poly, int codeword_length);
 euclidean_result extended_euclidean_algorithm(uint8_t *syndrome_poly, int syndrome_poly_len);
 uint8_t *calculate_error_values(uint8_t *error_positions, uint8_t *error_evaluator_polynomial,
                                 uint8_t *error_locator_polynomial, int error_amount, int error_locator_polynomial_len,
                                 int error_evaluator_polynomial_len);
 uint8_t *calculate_error_positions(uint8_t *poly, int poly_len, int *num_positions);
+int correct_few_errors(const uint8_t *syndrome_poly, uint8_t *error_vector, int message_len);
+int locate_errors(const uint8_t *syndromes, uint8_t *error_vector, int message_len);
+int locate_errors_and_erasures(const uint8_t *syndromes, const int *erasure_positions,
+                               int num_erasures, uint8_t *error_vector, int message_len);
 uint8_t *resolve_errors(uint8_t *error_vector, uint8_t *received_message, int message_len);
 
 // Main decoding function
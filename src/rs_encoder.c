@@ -22,7 +22,7 @@
 
 // zeros so that the array does not need to be padded to length 255 during runtime, handy for
 // poly_div
-static const uint8_t generator_poly[255] = {
+const uint8_t generator_poly[255] = {
     1,   232, 29,  189, 50, 142, 246, 232, 15,  43,  82, 164, 238, 1,  158, 13, 119, 158, 224,
     134, 227, 210, 163, 50, 107, 40,  27,  104, 253, 24, 239, 216, 45, 0,   0,  0,   0,   0,
     0,   0,   0,   0,   0,  0,   0,   0,   0,   0,   0,  0,   0,   0,  0,   0,  0,   0,   0,
@@ -65,6 +65,17 @@ uint8_t *shift_array(const uint8_t *array, int len, int k) {
     return out;
 }
 
+/**
+ * @brief Scales the generator polynomial so that its leading coefficient is 1, as needed by the
+ * LFSR encoders
+ * @param monic Output array for the NUM_SYNDROMES lower coefficients, the x^32 coefficient is 1
+ */
+void calculate_monic_generator(uint8_t *monic) {
+    for (int t = 0; t < NUM_SYNDROMES; t++) {
+        monic[t] = gf_div(generator_poly[t], generator_poly[NUM_SYNDROMES]);
+    }
+}
+
 /**
  * @brief encodeds a message of up to 223 length with a reed-solomon encoder
  * @param info_poly the array that is going to be encoded
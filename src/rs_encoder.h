@@ -6,9 +6,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+extern const uint8_t generator_poly[255];
+
 void reverse_array(uint8_t *arr, int len);
 uint8_t *extend_poly(const uint8_t *poly, int len, int extra);
 uint8_t *shift_poly(const uint8_t *poly, int len, int k);
+void calculate_monic_generator(uint8_t *monic);
 uint8_t *rs_encode(uint8_t *info_poly, int info_poly_len);
 
 #endif
@@ -0,0 +1,250 @@
+/**
+ * Reed-Solomon CRC32C Framing
+ *
+ * Optional framing mode that stores a CRC32C after a group of RS(223,255) codewords. On receive
+ * the CRC is checked first and the syndrome computation and decoder only run when it fails, so
+ * clean frames cost a single CRC pass. On x86-64 CPUs with SSE4.2 the CRC uses the hardware crc32
+ * instruction, other targets fall back to a bitwise implementation. The crc32 instruction has a
+ * latency of three cycles, so with PCLMULQDQ available three independent streams are run side by
+ * side and their CRCs combined with a carry-less multiply.
+ *
+ * Memory Layout:
+ *  frame: [codeword 0]...[codeword n-1][CRC32C, little-endian]
+ *  Total length: n * 255 + 4 symbols
+ *
+ * The codewords inside a frame are byte-for-byte the output of rs_encode.
+ */
+#include "rs_frame.h"
+#include "galois.h"
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <nmmintrin.h>
+#include <wmmintrin.h>
+#define HAVE_CRC32C_HW 1
+#endif
+
+// Reflected Castagnoli polynomial
+static const uint32_t CRC32C_POLY = 0x82F63B78;
+
+// Bytes per stream in the interleaved hardware CRC
+#define CRC_LANE_LEN 256
+
+// x^(8n - 33) mod P for n = CRC_LANE_LEN and 2 * CRC_LANE_LEN. The extra x^-33 cancels the x^32
+// applied by the crc32 instruction and the x^1 of the reflected carry-less product.
+static const uint32_t CRC_SHIFT_ONE_LANE = 0xB9E02B86;
+static const uint32_t CRC_SHIFT_TWO_LANES = 0xDD7E3B0C;
+
+/**
+ * @brief Computes CRC32C one bit at a time, used when the CPU has no crc32 instruction
+ * @param crc Running CRC value
+ * @param data Bytes to process
+ * @param len Number of bytes
+ * @return Updated CRC value
+ */
+static uint32_t crc32c_sw(uint32_t crc, const uint8_t *data, size_t len) {
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (CRC32C_POLY & (0u - (crc & 1)));
+        }
+    }
+    return crc;
+}
+
+#ifdef HAVE_CRC32C_HW
+/**
+ * @brief Computes CRC32C eight bytes at a time with the SSE4.2 crc32 instruction
+ * @param crc Running CRC value
+ * @param data Bytes to process
+ * @param len Number of bytes
+ * @return Updated CRC value
+ */
+__attribute__((target("sse4.2"))) static uint32_t crc32c_hw(uint32_t crc, const uint8_t *data,
+                                                            size_t len) {
+    uint64_t crc64 = crc;
+    while (len >= 8) {
+        uint64_t word;
+        memcpy(&word, data, sizeof(word));
+        crc64 = _mm_crc32_u64(crc64, word);
+        data += 8;
+        len -= 8;
+    }
+
+    crc = (uint32_t)crc64;
+    while (len > 0) {
+        crc = _mm_crc32_u8(crc, *data);
+        data++;
+        len--;
+    }
+    return crc;
+}
+
+/**
+ * @brief Advances a CRC past n zero bytes, equivalent to multiplying it by x^(8n) mod P
+ * @param crc CRC value
+ * @param shift_constant CRC_SHIFT_ONE_LANE or CRC_SHIFT_TWO_LANES for n = 1 or 2 lanes
+ * @return Shifted CRC value
+ */
+__attribute__((target("sse4.2,pclmul"))) static uint32_t crc32c_shift(uint32_t crc,
+                                                                      uint32_t shift_constant) {
+    __m128i crc_vector = _mm_cvtsi32_si128((int)crc);
+    __m128i shift_vector = _mm_cvtsi32_si128((int)shift_constant);
+    __m128i product = _mm_clmulepi64_si128(crc_vector, shift_vector, 0);
+    return (uint32_t)_mm_crc32_u64(0, (uint64_t)_mm_cvtsi128_si64(product));
+}
+
+/**
+ * @brief Computes CRC32C over three interleaved streams of CRC_LANE_LEN bytes, so consecutive crc32
+ * instructions do not wait on each other. The CRC of A || B || C started from crc is
+ * shift(crc_A, |B| + |C|) ^ shift(crc_B, |C|) ^ crc_C, where crc_B and crc_C start from 0.
+ * @param crc Running CRC value
+ * @param data Bytes to process
+ * @param len Number of bytes
+ * @return Updated CRC value
+ */
+__attribute__((target("sse4.2,pclmul"))) static uint32_t
+crc32c_hw_interleaved(uint32_t crc, const uint8_t *data, size_t len) {
+    uint64_t crc0 = crc;
+    while (len >= 3 * CRC_LANE_LEN) {
+        uint64_t crc1 = 0;
+        uint64_t crc2 = 0;
+        for (size_t i = 0; i < CRC_LANE_LEN; i += 8) {
+            uint64_t word0, word1, word2;
+            memcpy(&word0, data + i, sizeof(word0));
+            memcpy(&word1, data + CRC_LANE_LEN + i, sizeof(word1));
+            memcpy(&word2, data + 2 * CRC_LANE_LEN + i, sizeof(word2));
+            crc0 = _mm_crc32_u64(crc0, word0);
+            crc1 = _mm_crc32_u64(crc1, word1);
+            crc2 = _mm_crc32_u64(crc2, word2);
+        }
+        crc0 = crc32c_shift((uint32_t)crc0, CRC_SHIFT_TWO_LANES) ^
+               crc32c_shift((uint32_t)crc1, CRC_SHIFT_ONE_LANE) ^ (uint32_t)crc2;
+        data += 3 * CRC_LANE_LEN;
+        len -= 3 * CRC_LANE_LEN;
+    }
+
+    return crc32c_hw((uint32_t)crc0, data, len);
+}
+#endif
+
+/**
+ * @brief Calculates the CRC32C (Castagnoli) checksum of a buffer
+ * @param data Bytes to checksum
+ * @param len Number of bytes
+ * @return CRC32C of data
+ */
+uint32_t crc32c(const uint8_t *data, size_t len) {
+#ifdef HAVE_CRC32C_HW
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("pclmul")) {
+        return ~crc32c_hw_interleaved(~0u, data, len);
+    }
+    if (__builtin_cpu_supports("sse4.2")) return ~crc32c_hw(~0u, data, len);
+#endif
+    return ~crc32c_sw(~0u, data, len);
+}
+
+/**
+ * @brief Calculates the length of a frame holding a number of codewords
+ * @param num_codewords Number of codewords in the frame
+ * @return Frame length in bytes including the CRC
+ */
+int frame_length(int num_codewords) { return num_codewords * FIELD_SIZE + FRAME_CRC_LEN; }
+
+/**
+ * @brief Reads the CRC32C stored after the codewords of a frame
+ * @param frame Frame produced by rs_encode_framed
+ * @param num_codewords Number of codewords in the frame
+ * @return Stored CRC value
+ */
+static uint32_t frame_stored_crc(const uint8_t *frame, int num_codewords) {
+    const uint8_t *stored = frame + num_codewords * FIELD_SIZE;
+    return (uint32_t)stored[0] | (uint32_t)stored[1] << 8 | (uint32_t)stored[2] << 16 |
+           (uint32_t)stored[3] << 24;
+}
+
+/**
+ * @brief Checks the CRC32C of a frame without touching the Reed-Solomon decoder
+ * @param frame Frame produced by rs_encode_framed
+ * @param num_codewords Number of codewords in the frame
+ * @return 1 if the stored CRC matches the codewords, 0 otherwise
+ */
+int frame_is_clean(const uint8_t *frame, int num_codewords) {
+    return crc32c(frame, num_codewords * FIELD_SIZE) == frame_stored_crc(frame, num_codewords);
+}
+
+/**
+ * @brief Encodes a group of messages with rs_encode and appends a CRC32C over the codewords
+ * @param info num_codewords consecutive messages of 223 bytes each
+ * @param num_codewords Number of messages to encode
+ * @return Frame of length frame_length(num_codewords)
+ */
+uint8_t *rs_encode_framed(uint8_t *info, int num_codewords) {
+    int info_len = FIELD_SIZE - NUM_SYNDROMES;
+    int payload_len = num_codewords * FIELD_SIZE;
+    uint8_t *frame = malloc(frame_length(num_codewords) * sizeof(uint8_t));
+
+    for (int i = 0; i < num_codewords; i++) {
+        uint8_t *encoded_message = rs_encode(info + i * info_len, info_len);
+        memcpy(frame + i * FIELD_SIZE, encoded_message, FIELD_SIZE * sizeof(uint8_t));
+        free(encoded_message);
+    }
+
+    uint32_t crc = crc32c(frame, payload_len);
+    frame[payload_len] = crc & 0xFF;
+    frame[payload_len + 1] = (crc >> 8) & 0xFF;
+    frame[payload_len + 2] = (crc >> 16) & 0xFF;
+    frame[payload_len + 3] = (crc >> 24) & 0xFF;
+
+    return frame;
+}
+
+/**
+ * @brief Decodes a frame, only running the Reed-Solomon decoder when the CRC check fails
+ * @param frame Received frame, potentially containing errors
+ * @param num_codewords Number of codewords in the frame
+ * @param status Output parameter, set to the number of corrected symbols (0 for a clean frame), or
+ * -1 if any codeword is uncorrectable or the corrected codewords still fail the CRC, meaning the
+ * decoder miscorrected. Uncorrectable codewords are returned as received.
+ * @return The num_codewords decoded codewords without the CRC
+ */
+uint8_t *decode_framed_message(uint8_t *frame, int num_codewords, int *status) {
+    int payload_len = num_codewords * FIELD_SIZE;
+    uint8_t *decoded = malloc(payload_len * sizeof(uint8_t));
+
+    memcpy(decoded, frame, payload_len * sizeof(uint8_t));
+    *status = 0;
+    if (frame_is_clean(frame, num_codewords)) return decoded;
+
+    decoder_log("Frame CRC mismatch - decoding %d codewords\n", num_codewords);
+    for (int i = 0; i < num_codewords; i++) {
+        uint8_t *codeword = decoded + i * FIELD_SIZE;
+        uint8_t syndromes[NUM_SYNDROMES];
+        if (!compute_syndromes(codeword, FIELD_SIZE, syndromes)) continue;
+
+        uint8_t error_vector[FIELD_SIZE];
+        memset(error_vector, 0, sizeof(error_vector));
+        int num_errors = locate_errors(syndromes, error_vector, FIELD_SIZE);
+        if (num_errors < 0) {
+            *status = -1;
+            continue;
+        }
+
+        for (int j = 0; j < FIELD_SIZE; j++) {
+            codeword[j] = gf_add(codeword[j], error_vector[j]);
+        }
+        if (*status >= 0) *status += num_errors;
+    }
+
+    // With no corrections the mismatch can only come from the CRC bytes themselves
+    if (*status > 0 && crc32c(decoded, payload_len) != frame_stored_crc(frame, num_codewords)) {
+        decoder_log("Frame CRC still fails after correcting %d symbols\n", *status);
+        *status = -1;
+    }
+
+    return decoded;
+}
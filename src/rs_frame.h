@@ -0,0 +1,18 @@
+#ifndef RS_FRAME_H
+#define RS_FRAME_H
+
+#include "galois.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+// Number of CRC32C bytes appended after the codewords of a frame
+#define FRAME_CRC_LEN 4
+
+uint32_t crc32c(const uint8_t *data, size_t len);
+int frame_length(int num_codewords);
+int frame_is_clean(const uint8_t *frame, int num_codewords);
+uint8_t *rs_encode_framed(uint8_t *info, int num_codewords);
+uint8_t *decode_framed_message(uint8_t *frame, int num_codewords, int *status);
+
+#endif // RS_FRAME_H
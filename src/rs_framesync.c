@@ -0,0 +1,120 @@
+/**
+ * Reed-Solomon Frame Synchronisation
+ *
+ * Finds codeword boundaries in an unframed byte stream by keeping the syndromes of a 255 symbol
+ * window up to date as it slides one symbol at a time. With S_i = sum w_j * alpha^(i(254 - j)) and
+ * alpha^(255 i) = 1, shifting the window by one symbol gives
+ *
+ *  S_i' = S_i * alpha^i + outgoing + incoming
+ *
+ * so every shift costs NUM_SYNDROMES multiplications instead of a full recomputation. Windows with
+ * all-zero syndromes are reported as clean codewords, and windows whose syndromes match one or two
+ * symbol errors (correct_few_errors) are reported as correctable. Windows with more errors are not
+ * detected, decode_message can be run on them once the boundary is known.
+ *
+ * RS codes are cyclic, so a window shifted by k symbols from a codeword boundary differs from a
+ * codeword in at most k extra symbols. The offsets next to a boundary can therefore also be
+ * reported as correctable; the true boundary is the hit with the fewest errors in such a cluster.
+ *
+ * The state persists between calls, so a live stream can be fed in chunks of any size.
+ */
+#include "rs_framesync.h"
+#include "galois.h"
+#include "rs_decoder.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Creates an empty frame synchroniser
+ * @return New frame_sync state, free with frame_sync_free
+ */
+frame_sync *frame_sync_create() {
+    frame_sync *sync = malloc(sizeof(frame_sync));
+    sync->window = calloc(FIELD_SIZE, sizeof(uint8_t));
+    sync->syndromes = calloc(NUM_SYNDROMES, sizeof(uint8_t));
+    sync->alpha_powers = malloc(NUM_SYNDROMES * sizeof(uint8_t));
+    sync->error_vector = calloc(FIELD_SIZE, sizeof(uint8_t));
+    sync->symbols_seen = 0;
+
+    for (int i = 0; i < NUM_SYNDROMES; i++) {
+        sync->alpha_powers[i] = gf_pow(2, i + 1);
+    }
+
+    return sync;
+}
+
+/**
+ * @brief Frees a frame synchroniser
+ * @param sync State created by frame_sync_create
+ */
+void frame_sync_free(frame_sync *sync) {
+    free(sync->window);
+    free(sync->syndromes);
+    free(sync->alpha_powers);
+    free(sync->error_vector);
+    free(sync);
+}
+
+/**
+ * @brief Slides the window one symbol forward and classifies the new window
+ * @param sync Frame synchroniser state
+ * @param symbol Next symbol of the stream
+ * @param num_errors Output parameter for the number of errors in the window, may be NULL
+ * @return Status of the window ending with symbol, which starts at stream offset
+ * symbols_seen - FIELD_SIZE
+ */
+frame_sync_status frame_sync_push(frame_sync *sync, uint8_t symbol, int *num_errors) {
+    int slot = sync->symbols_seen % FIELD_SIZE;
+    // Until the window is full the outgoing symbol is one of the initial zeros
+    uint8_t outgoing = sync->window[slot];
+    uint8_t delta = gf_add(outgoing, symbol);
+    uint8_t any_nonzero = 0;
+
+    sync->window[slot] = symbol;
+    sync->symbols_seen++;
+
+    for (int i = 0; i < NUM_SYNDROMES; i++) {
+        uint8_t *syndrome = &sync->syndromes[NUM_SYNDROMES - 1 - i];
+        *syndrome = gf_add(gf_mult(*syndrome, sync->alpha_powers[i]), delta);
+        any_nonzero |= *syndrome;
+    }
+
+    if (num_errors) *num_errors = 0;
+    if (sync->symbols_seen < (uint64_t)FIELD_SIZE) return FRAME_SYNC_NONE;
+    if (!any_nonzero) return FRAME_SYNC_CLEAN;
+
+    int few_errors = correct_few_errors(sync->syndromes, sync->error_vector, FIELD_SIZE);
+    if (few_errors == 0) return FRAME_SYNC_NONE;
+
+    memset(sync->error_vector, 0, FIELD_SIZE * sizeof(uint8_t));
+    if (num_errors) *num_errors = few_errors;
+    return FRAME_SYNC_CORRECTABLE;
+}
+
+/**
+ * @brief Feeds a chunk of the stream and records every window that is a codeword
+ * @param sync Frame synchroniser state
+ * @param stream Next chunk of the stream
+ * @param len Length of the chunk
+ * @param hits Output array for the codeword positions found
+ * @param max_hits Capacity of hits, further codewords are scanned but not recorded
+ * @return Number of hits recorded
+ */
+int frame_sync_scan(frame_sync *sync, const uint8_t *stream, size_t len, frame_sync_hit *hits,
+                    int max_hits) {
+    int num_hits = 0;
+
+    for (size_t k = 0; k < len; k++) {
+        int num_errors;
+        frame_sync_status status = frame_sync_push(sync, stream[k], &num_errors);
+        if (status == FRAME_SYNC_NONE || num_hits >= max_hits) continue;
+
+        hits[num_hits].offset = sync->symbols_seen - FIELD_SIZE;
+        hits[num_hits].status = status;
+        hits[num_hits].num_errors = num_errors;
+        num_hits++;
+    }
+
+    return num_hits;
+}
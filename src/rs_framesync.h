@@ -0,0 +1,36 @@
+#ifndef RS_FRAMESYNC_H
+#define RS_FRAMESYNC_H
+
+#include "galois.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+typedef enum {
+    FRAME_SYNC_NONE,        // Window is not a codeword, or the stream is shorter than a codeword
+    FRAME_SYNC_CLEAN,       // All syndromes are zero
+    FRAME_SYNC_CORRECTABLE, // Window is a codeword with one or two symbol errors
+} frame_sync_status;
+
+// Sliding 255 symbol window with its syndromes
+typedef struct {
+    uint8_t *window;        // Ring buffer of the last FIELD_SIZE symbols
+    uint8_t *syndromes;     // Same layout as compute_syndromes, NUM_SYNDROMES symbols
+    uint8_t *alpha_powers;  // alpha^i for i = 1..NUM_SYNDROMES
+    uint8_t *error_vector;  // Scratch space for correct_few_errors
+    uint64_t symbols_seen;  // Number of symbols pushed so far
+} frame_sync;
+
+typedef struct {
+    uint64_t offset;          // Stream offset of the first symbol of the codeword
+    frame_sync_status status; // FRAME_SYNC_CLEAN or FRAME_SYNC_CORRECTABLE
+    int num_errors;           // Number of symbol errors in the window
+} frame_sync_hit;
+
+frame_sync *frame_sync_create();
+void frame_sync_free(frame_sync *sync);
+frame_sync_status frame_sync_push(frame_sync *sync, uint8_t symbol, int *num_errors);
+int frame_sync_scan(frame_sync *sync, const uint8_t *stream, size_t len, frame_sync_hit *hits,
+                    int max_hits);
+
+#endif // RS_FRAMESYNC_H
@@ -0,0 +1,216 @@
+/**
+ * Reed-Solomon Scatter-Gather Interface
+ *
+ * Encode, check and decode entry points for codewords whose symbols are spread over several
+ * caller-owned buffers, such as chains of packet buffers. Nothing is linearized: parity symbols are
+ * written straight into the parity segments and corrections are applied in place.
+ *
+ * Memory Layout:
+ *  parity segments: 32 parity symbols in total, in the same order as rs_encode
+ *  data segments: up to 223 information symbols in total, missing symbols are treated as zeros
+ *  The codeword seen by the decoder is [parity symbols][data symbols][zero padding], 255 symbols
+ */
+#include "rs_iov.h"
+#include "galois.h"
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Sums the lengths of an iovec array
+ * @param iov Segments
+ * @param iov_cnt Number of segments
+ * @return Total number of bytes
+ */
+static size_t iov_total(const struct iovec *iov, int iov_cnt) {
+    size_t total = 0;
+    for (int i = 0; i < iov_cnt; i++) {
+        total += iov[i].iov_len;
+    }
+    return total;
+}
+
+/**
+ * @brief Checks that a set of segments forms a valid codeword layout
+ * @param data Information segments
+ * @param data_cnt Number of information segments
+ * @param parity Parity segments
+ * @param parity_cnt Number of parity segments
+ * @return Number of information symbols, or -1 if the lengths do not fit RS(223,255)
+ */
+static int codeword_data_len(const struct iovec *data, int data_cnt, const struct iovec *parity,
+                             int parity_cnt) {
+    size_t data_len = iov_total(data, data_cnt);
+    if (data_len > (size_t)(FIELD_SIZE - NUM_SYNDROMES)) return -1;
+    if (iov_total(parity, parity_cnt) != (size_t)NUM_SYNDROMES) return -1;
+    return (int)data_len;
+}
+
+/**
+ * @brief Returns a pointer to one symbol of a segmented buffer
+ * @param iov Segments
+ * @param iov_cnt Number of segments
+ * @param index Symbol index across all segments
+ * @return Pointer to the symbol, or NULL if index is past the end of the segments
+ */
+static uint8_t *iov_symbol(const struct iovec *iov, int iov_cnt, size_t index) {
+    for (int i = 0; i < iov_cnt; i++) {
+        if (index < iov[i].iov_len) return (uint8_t *)iov[i].iov_base + index;
+        index -= iov[i].iov_len;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Evaluates one syndrome over a segmented codeword using Horner's method
+ * @param data Information segments
+ * @param data_cnt Number of information segments
+ * @param parity Parity segments
+ * @param parity_cnt Number of parity segments
+ * @param padding Number of zero symbols following the information symbols
+ * @param alpha_i Point to evaluate at
+ * @return The syndrome value
+ */
+static uint8_t iov_syndrome(const struct iovec *data, int data_cnt, const struct iovec *parity,
+                            int parity_cnt, int padding, uint8_t alpha_i) {
+    uint8_t result = 0;
+
+    for (int s = 0; s < parity_cnt; s++) {
+        const uint8_t *bytes = parity[s].iov_base;
+        for (size_t j = 0; j < parity[s].iov_len; j++) {
+            result = gf_add(gf_mult(result, alpha_i), bytes[j]);
+        }
+    }
+    for (int s = 0; s < data_cnt; s++) {
+        const uint8_t *bytes = data[s].iov_base;
+        for (size_t j = 0; j < data[s].iov_len; j++) {
+            result = gf_add(gf_mult(result, alpha_i), bytes[j]);
+        }
+    }
+
+    return gf_mult(result, gf_pow(alpha_i, padding));
+}
+
+/**
+ * @brief Calculates all syndromes of a segmented codeword
+ * @param data Information segments
+ * @param data_cnt Number of information segments
+ * @param parity Parity segments
+ * @param parity_cnt Number of parity segments
+ * @param data_len Number of information symbols
+ * @param syndrome_output Output array of at least NUM_SYNDROMES symbols, same order as
+ * compute_syndromes
+ * @return 1 if any syndrome is non-zero, 0 otherwise
+ */
+static int iov_syndromes(const struct iovec *data, int data_cnt, const struct iovec *parity,
+                         int parity_cnt, int data_len, uint8_t *syndrome_output) {
+    uint8_t alpha = 2;
+    int padding = FIELD_SIZE - NUM_SYNDROMES - data_len;
+    int errors_detected = 0;
+
+    for (int i = 0; i < NUM_SYNDROMES; i++) {
+        uint8_t result =
+            iov_syndrome(data, data_cnt, parity, parity_cnt, padding, gf_pow(alpha, i + 1));
+        syndrome_output[NUM_SYNDROMES - 1 - i] = result;
+        if (result != 0) errors_detected = 1;
+    }
+
+    return errors_detected;
+}
+
+/**
+ * @brief Encodes a segmented message, writing the parity symbols into the parity segments
+ * @param data Information segments, up to 223 symbols in total
+ * @param data_cnt Number of information segments
+ * @param parity Parity segments, exactly 32 symbols in total
+ * @param parity_cnt Number of parity segments
+ * @return 0 on success, -1 if the segment lengths do not fit RS(223,255)
+ */
+int rs_encode_iov(const struct iovec *data, int data_cnt, const struct iovec *parity,
+                  int parity_cnt) {
+    if (codeword_data_len(data, data_cnt, parity, parity_cnt) < 0) return -1;
+
+    uint8_t monic_generator[NUM_SYNDROMES];
+    calculate_monic_generator(monic_generator);
+
+    // LFSR division by the generator, fed with the highest degree (last) information symbol first.
+    // The zero padding after the data does not change the remainder and is skipped.
+    uint8_t remainder[NUM_SYNDROMES];
+    memset(remainder, 0, sizeof(remainder));
+    for (int s = data_cnt - 1; s >= 0; s--) {
+        const uint8_t *bytes = data[s].iov_base;
+        for (size_t j = data[s].iov_len; j > 0; j--) {
+            uint8_t feedback = gf_add(bytes[j - 1], remainder[NUM_SYNDROMES - 1]);
+            for (int t = NUM_SYNDROMES - 1; t > 0; t--) {
+                remainder[t] = gf_add(remainder[t - 1], gf_mult(feedback, monic_generator[t]));
+            }
+            remainder[0] = gf_mult(feedback, monic_generator[0]);
+        }
+    }
+
+    int t = 0;
+    for (int s = 0; s < parity_cnt; s++) {
+        memcpy(parity[s].iov_base, remainder + t, parity[s].iov_len);
+        t += parity[s].iov_len;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Checks a segmented codeword for errors without modifying it
+ * @param data Information segments
+ * @param data_cnt Number of information segments
+ * @param parity Parity segments
+ * @param parity_cnt Number of parity segments
+ * @return 1 if the codeword is error-free, 0 if errors are detected, -1 if the segment lengths do
+ * not fit RS(223,255)
+ */
+int check_iov(const struct iovec *data, int data_cnt, const struct iovec *parity, int parity_cnt) {
+    int data_len = codeword_data_len(data, data_cnt, parity, parity_cnt);
+    if (data_len < 0) return -1;
+
+    uint8_t syndromes[NUM_SYNDROMES];
+    return !iov_syndromes(data, data_cnt, parity, parity_cnt, data_len, syndromes);
+}
+
+/**
+ * @brief Corrects a segmented codeword in place
+ * @param data Information segments
+ * @param data_cnt Number of information segments
+ * @param parity Parity segments
+ * @param parity_cnt Number of parity segments
+ * @return Number of corrected errors, or -1 if the codeword is uncorrectable or the segment lengths
+ * do not fit RS(223,255). The segments are left untouched when -1 is returned.
+ */
+int decode_iov(const struct iovec *data, int data_cnt, const struct iovec *parity, int parity_cnt) {
+    int data_len = codeword_data_len(data, data_cnt, parity, parity_cnt);
+    if (data_len < 0) return -1;
+
+    uint8_t syndromes[NUM_SYNDROMES];
+    if (!iov_syndromes(data, data_cnt, parity, parity_cnt, data_len, syndromes)) return 0;
+
+    uint8_t error_vector[FIELD_SIZE];
+    memset(error_vector, 0, sizeof(error_vector));
+    int num_errors = locate_errors(syndromes, error_vector, FIELD_SIZE);
+    if (num_errors < 0) return -1;
+
+    // An error in the zero padding means the decoder picked the wrong codeword
+    for (int position = NUM_SYNDROMES + data_len; position < FIELD_SIZE; position++) {
+        if (error_vector[position] != 0) return -1;
+    }
+
+    for (int position = 0; position < NUM_SYNDROMES + data_len; position++) {
+        if (error_vector[position] == 0) continue;
+
+        uint8_t *symbol = position < NUM_SYNDROMES
+                              ? iov_symbol(parity, parity_cnt, position)
+                              : iov_symbol(data, data_cnt, position - NUM_SYNDROMES);
+        *symbol = gf_add(*symbol, error_vector[position]);
+    }
+
+    return num_errors;
+}
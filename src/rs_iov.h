@@ -0,0 +1,14 @@
+#ifndef RS_IOV_H
+#define RS_IOV_H
+
+#include "galois.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/uio.h>
+
+int rs_encode_iov(const struct iovec *data, int data_cnt, const struct iovec *parity,
+                  int parity_cnt);
+int check_iov(const struct iovec *data, int data_cnt, const struct iovec *parity, int parity_cnt);
+int decode_iov(const struct iovec *data, int data_cnt, const struct iovec *parity, int parity_cnt);
+
+#endif // RS_IOV_H
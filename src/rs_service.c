@@ -0,0 +1,304 @@
+/**
+ * Reed-Solomon Shared-Memory Codec Service, client side
+ *
+ * Processes talk to the codec daemon (rs_serviced) through a POSIX shared memory object. A client
+ * claims a slot from the free ring, writes its message or codeword straight into the slot payload,
+ * and pushes the slot index onto the job ring. Workers in the daemon pop jobs in batches, operate
+ * on the payload in place, mark the slot done and wake the client through a futex on the slot
+ * state. Clients therefore need neither the GF tables nor their own worker threads.
+ *
+ * Both rings are bounded lock-free MPMC queues (sequence number per cell), so any number of
+ * client processes and daemon workers can use them concurrently. Linux only (futex).
+ *
+ * Clients wait with a timeout and check between timeouts that the daemon is still alive and
+ * running, so a stopped or crashed daemon makes service_wait fail with SERVICE_ERROR instead of
+ * blocking forever.
+ */
+#include "rs_service.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// How long service_wait sleeps before checking that the daemon is still alive
+#define SERVICE_POLL_NS 100000000
+
+/**
+ * @brief Initialises a ring
+ * @param ring Ring to initialise
+ * @param full 1 to fill the ring with every slot index, 0 to leave it empty
+ */
+void ring_init(service_ring *ring, int full) {
+    for (uint64_t i = 0; i < SERVICE_SLOTS; i++) {
+        ring->cells[i].value = (uint32_t)i;
+        // A cell whose sequence equals its position is free to push, position + 1 to pop
+        atomic_store(&ring->cells[i].sequence, full ? i + 1 : i);
+    }
+    atomic_store(&ring->head, full ? SERVICE_SLOTS : 0);
+    atomic_store(&ring->tail, 0);
+}
+
+/**
+ * @brief Pushes a value onto a ring
+ * @param ring Ring shared between processes
+ * @param value Value to push
+ * @return 1 on success, 0 if the ring is full
+ */
+int ring_push(service_ring *ring, uint32_t value) {
+    uint64_t pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    service_ring_cell *cell;
+
+    for (;;) {
+        cell = &ring->cells[pos & (SERVICE_SLOTS - 1)];
+        uint64_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        int64_t diff = (int64_t)(sequence - pos);
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->head, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        }
+    }
+
+    cell->value = value;
+    atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release);
+    return 1;
+}
+
+/**
+ * @brief Pops a value from a ring
+ * @param ring Ring shared between processes
+ * @param value Output parameter for the popped value
+ * @return 1 on success, 0 if the ring is empty
+ */
+int ring_pop(service_ring *ring, uint32_t *value) {
+    uint64_t pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    service_ring_cell *cell;
+
+    for (;;) {
+        cell = &ring->cells[pos & (SERVICE_SLOTS - 1)];
+        uint64_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire);
+        int64_t diff = (int64_t)(sequence - (pos + 1));
+
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&ring->tail, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed))
+                break;
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        }
+    }
+
+    *value = cell->value;
+    atomic_store_explicit(&cell->sequence, pos + SERVICE_SLOTS, memory_order_release);
+    return 1;
+}
+
+/**
+ * @brief Sleeps until *addr is woken, returns immediately if *addr no longer equals expected
+ * @param addr Futex word in shared memory
+ * @param expected Value *addr must still hold for the caller to sleep
+ * @param timeout Longest time to sleep, NULL to sleep until woken
+ * @return 0 when woken, -1 with errno set to ETIMEDOUT, EAGAIN or EINTR otherwise
+ */
+int futex_wait(_Atomic uint32_t *addr, uint32_t expected, const struct timespec *timeout) {
+    return (int)syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAIT, expected, timeout, NULL, 0);
+}
+
+/**
+ * @brief Wakes processes sleeping on a futex word
+ * @param addr Futex word in shared memory
+ * @param count Maximum number of waiters to wake
+ */
+void futex_wake(_Atomic uint32_t *addr, int count) {
+    syscall(SYS_futex, (uint32_t *)addr, FUTEX_WAKE, count, NULL, NULL, 0);
+}
+
+/**
+ * @brief Checks whether the daemon behind a segment still runs jobs
+ * @param shm Shared memory segment
+ * @return 1 if the daemon is alive and has not stopped, 0 otherwise
+ */
+static int daemon_running(service_shm *shm) {
+    if (atomic_load(&shm->shutdown) == SERVICE_STOPPED) return 0;
+    // EPERM still means the process exists, only ESRCH shows that it is gone
+    return kill((pid_t)atomic_load(&shm->daemon_pid), 0) == 0 || errno != ESRCH;
+}
+
+/**
+ * @brief Connects to a running codec daemon
+ * @param name Name of the shared memory object, NULL for SERVICE_DEFAULT_NAME
+ * @return Client connection, or NULL if no initialised daemon is found
+ */
+service_client *service_connect(const char *name) {
+    if (!name) name = SERVICE_DEFAULT_NAME;
+
+    int fd = shm_open(name, O_RDWR, 0);
+    if (fd < 0) {
+        perror("shm_open");
+        return NULL;
+    }
+
+    // A truncated or foreign object would fault on the first access past its end
+    struct stat object_stat;
+    if (fstat(fd, &object_stat) != 0 || object_stat.st_size < (off_t)sizeof(service_shm)) {
+        fprintf(stderr, "Codec service %s is not initialised\n", name);
+        close(fd);
+        return NULL;
+    }
+
+    service_shm *shm = mmap(NULL, sizeof(service_shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (shm == MAP_FAILED) {
+        perror("mmap");
+        close(fd);
+        return NULL;
+    }
+
+    if (atomic_load(&shm->magic) != SERVICE_MAGIC || atomic_load(&shm->shutdown) ||
+        !daemon_running(shm)) {
+        fprintf(stderr, "Codec service %s is not running\n", name);
+        munmap(shm, sizeof(service_shm));
+        close(fd);
+        return NULL;
+    }
+
+    service_client *client = malloc(sizeof(service_client));
+    client->fd = fd;
+    client->shm = shm;
+    return client;
+}
+
+/**
+ * @brief Closes a client connection, slots still held by the client are not returned
+ * @param client Connection from service_connect
+ */
+void service_disconnect(service_client *client) {
+    munmap(client->shm, sizeof(service_shm));
+    close(client->fd);
+    free(client);
+}
+
+/**
+ * @brief Checks that a slot index passed in by the caller lies inside the segment
+ * @param slot Slot index
+ * @return 1 if the index is valid, 0 otherwise
+ */
+static int valid_slot(int slot) { return slot >= 0 && slot < SERVICE_SLOTS; }
+
+/**
+ * @brief Claims a free slot for a job
+ * @param client Connection from service_connect
+ * @return Slot index, or -1 if every slot is in use
+ */
+int service_acquire(service_client *client) {
+    uint32_t slot;
+    if (!ring_pop(&client->shm->free_slots, &slot) || slot >= SERVICE_SLOTS) return -1;
+
+    atomic_store(&client->shm->slots[slot].state, SLOT_CLAIMED);
+    return (int)slot;
+}
+
+/**
+ * @brief Returns the payload of a claimed slot, which the client fills and reads in place
+ * @param client Connection from service_connect
+ * @param slot Slot index from service_acquire
+ * @return SERVICE_CODEWORD_LEN byte payload in shared memory, or NULL for an invalid slot
+ */
+uint8_t *service_payload(service_client *client, int slot) {
+    if (!valid_slot(slot)) return NULL;
+    return client->shm->slots[slot].payload;
+}
+
+/**
+ * @brief Submits a claimed slot to the daemon without waiting for the result
+ * @param client Connection from service_connect
+ * @param slot Slot index from service_acquire
+ * @param op Operation to perform on the payload
+ * @return 0 on success, SERVICE_ERROR if the slot or op is invalid or the service is shutting down
+ */
+int service_submit(service_client *client, int slot, service_op op) {
+    service_shm *shm = client->shm;
+
+    if (!valid_slot(slot)) return SERVICE_ERROR;
+    if (op != SERVICE_OP_ENCODE && op != SERVICE_OP_CHECK && op != SERVICE_OP_DECODE) {
+        return SERVICE_ERROR;
+    }
+    if (atomic_load(&shm->shutdown) != SERVICE_RUNNING) return SERVICE_ERROR;
+
+    shm->slots[slot].op = op;
+    atomic_store(&shm->slots[slot].state, SLOT_SUBMITTED);
+
+    // The ring has room for every slot, so this cannot fail
+    ring_push(&shm->jobs, (uint32_t)slot);
+    atomic_fetch_add(&shm->doorbell, 1);
+    if (atomic_load(&shm->sleepers) > 0) futex_wake(&shm->doorbell, 1);
+    return 0;
+}
+
+/**
+ * @brief Waits for a submitted job to complete
+ * @param client Connection from service_connect
+ * @param slot Slot index passed to service_submit
+ * @return Result of the operation, see service_op, or SERVICE_ERROR if the slot is invalid or not
+ * submitted, or the daemon stopped or died without completing the job
+ */
+int service_wait(service_client *client, int slot) {
+    if (!valid_slot(slot)) return SERVICE_ERROR;
+
+    service_slot *job = &client->shm->slots[slot];
+    struct timespec poll_interval = {0, SERVICE_POLL_NS};
+
+    for (;;) {
+        uint32_t state = atomic_load(&job->state);
+        if (state == SLOT_DONE) break;
+        // A slot that was never submitted, e.g. after service_submit failed, will never complete
+        if (state != SLOT_SUBMITTED) return SERVICE_ERROR;
+
+        if (futex_wait(&job->state, SLOT_SUBMITTED, &poll_interval) == 0 || errno != ETIMEDOUT) {
+            continue;
+        }
+        // The daemon may have completed the job just before it stopped
+        if (!daemon_running(client->shm) && atomic_load(&job->state) != SLOT_DONE) {
+            return SERVICE_ERROR;
+        }
+    }
+    return job->result;
+}
+
+/**
+ * @brief Returns a slot to the free ring once the client has read its payload
+ * @param client Connection from service_connect
+ * @param slot Slot index from service_acquire
+ */
+void service_release(service_client *client, int slot) {
+    if (!valid_slot(slot)) return;
+
+    atomic_store(&client->shm->slots[slot].state, SLOT_FREE);
+    ring_push(&client->shm->free_slots, (uint32_t)slot);
+}
+
+/**
+ * @brief Submits a job and waits for its result
+ * @param client Connection from service_connect
+ * @param slot Slot index from service_acquire
+ * @param op Operation to perform on the payload
+ * @return Result of the operation, see service_op, or SERVICE_ERROR if the service stopped
+ */
+int service_call(service_client *client, int slot, service_op op) {
+    if (service_submit(client, slot, op) != 0) return SERVICE_ERROR;
+    return service_wait(client, slot);
+}
@@ -0,0 +1,98 @@
+#ifndef RS_SERVICE_H
+#define RS_SERVICE_H
+
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Name of the POSIX shared memory object used when none is given
+#define SERVICE_DEFAULT_NAME "/rs_codec"
+
+// Number of job slots, must be a power of two
+#define SERVICE_SLOTS 1024
+
+// Codeword layout of a slot payload, identical to rs_encode
+#define SERVICE_CODEWORD_LEN 255
+#define SERVICE_PARITY_LEN 32
+#define SERVICE_INFO_LEN (SERVICE_CODEWORD_LEN - SERVICE_PARITY_LEN)
+
+#define SERVICE_MAGIC 0x52534356
+
+// Result of a job the service could not run because it stopped or died
+#define SERVICE_ERROR (-2)
+
+// Every operation results in SERVICE_ERROR instead if the service stops before running it
+typedef enum {
+    SERVICE_OP_ENCODE, // payload[32..254] holds the message, parity is written to payload[0..31]
+    SERVICE_OP_CHECK,  // result is 1 if the codeword is error-free, 0 otherwise
+    SERVICE_OP_DECODE, // codeword is corrected in place, result is the number of corrected errors
+                       // or -1 if it is uncorrectable
+} service_op;
+
+typedef enum { SLOT_FREE, SLOT_CLAIMED, SLOT_SUBMITTED, SLOT_DONE } slot_state;
+
+typedef enum {
+    SERVICE_RUNNING,  // Jobs are accepted
+    SERVICE_DRAINING, // No new jobs are accepted, workers finish the ones already submitted
+    SERVICE_STOPPED,  // Workers have exited, leftover jobs were completed with SERVICE_ERROR
+} service_status;
+
+// One job, the payload is read and written in place by the service
+typedef struct {
+    _Atomic uint32_t state; // slot_state, also the futex word the client waits on
+    int32_t op;
+    int32_t result;
+    uint8_t payload[SERVICE_CODEWORD_LEN];
+} service_slot;
+
+// Bounded lock-free multi-producer multi-consumer queue of slot indices
+typedef struct {
+    _Atomic uint64_t sequence;
+    uint32_t value;
+} service_ring_cell;
+
+typedef struct {
+    _Atomic uint64_t head;
+    char head_padding[56];
+    _Atomic uint64_t tail;
+    char tail_padding[56];
+    service_ring_cell cells[SERVICE_SLOTS];
+} service_ring;
+
+// Layout of the shared memory object
+typedef struct {
+    _Atomic uint32_t magic;      // SERVICE_MAGIC once the daemon has initialised the segment
+    _Atomic uint32_t shutdown;   // service_status, SERVICE_RUNNING until the daemon stops
+    _Atomic uint32_t doorbell;   // Futex word, incremented on every submitted job
+    _Atomic uint32_t sleepers;   // Number of workers waiting on the doorbell
+    _Atomic uint32_t daemon_pid; // Process ID of the daemon, used to detect a crashed daemon
+    service_ring free_slots;     // Slots clients can claim
+    service_ring jobs;           // Submitted slots waiting for a worker
+    service_slot slots[SERVICE_SLOTS];
+} service_shm;
+
+// Client connection to a running daemon
+typedef struct {
+    int fd;
+    service_shm *shm;
+} service_client;
+
+// Shared helpers
+void ring_init(service_ring *ring, int full);
+int ring_push(service_ring *ring, uint32_t value);
+int ring_pop(service_ring *ring, uint32_t *value);
+int futex_wait(_Atomic uint32_t *addr, uint32_t expected, const struct timespec *timeout);
+void futex_wake(_Atomic uint32_t *addr, int count);
+
+// Client API
+service_client *service_connect(const char *name);
+void service_disconnect(service_client *client);
+int service_acquire(service_client *client);
+uint8_t *service_payload(service_client *client, int slot);
+int service_submit(service_client *client, int slot, service_op op);
+int service_wait(service_client *client, int slot);
+void service_release(service_client *client, int slot);
+int service_call(service_client *client, int slot, service_op op);
+
+#endif // RS_SERVICE_H
@@ -0,0 +1,115 @@
+/**
+ * Reed-Solomon Shared-Memory Codec Service, example client
+ *
+ * Encodes random messages through a running rs_serviced, corrupts the codewords, then checks and
+ * decodes them through the service and verifies that the original codewords come back. The client
+ * never initialises the GF tables itself.
+ *
+ * Usage:
+ *  rs_service_client [-n shm name] [-c codewords] [-e errors per codeword]
+ */
+#include "rs_service.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Jobs kept in flight at once, so the daemon can batch them
+#define CLIENT_WINDOW 64
+
+/**
+ * @brief Returns a monotonic timestamp in seconds
+ */
+static double now_seconds() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+/**
+ * @brief Reports that the service went away and closes the connection
+ * @param client Connection from service_connect
+ * @return Exit status for main
+ */
+static int stop_client(service_client *client) {
+    fprintf(stderr, "Codec service stopped before all jobs completed\n");
+    service_disconnect(client);
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    const char *name = SERVICE_DEFAULT_NAME;
+    int num_codewords = 10000;
+    int errors_per_codeword = 8;
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:c:e:h")) != -1) {
+        switch (opt) {
+        case 'n': name = optarg; break;
+        case 'c': num_codewords = atoi(optarg); break;
+        case 'e': errors_per_codeword = atoi(optarg); break;
+        default:
+            printf("Usage: %s [-n shm name] [-c codewords] [-e errors per codeword]\n", argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    service_client *client = service_connect(name);
+    if (!client) return 1;
+
+    int slots[CLIENT_WINDOW];
+    uint8_t sent[CLIENT_WINDOW][SERVICE_CODEWORD_LEN];
+    int failures = 0;
+    srand(1);
+
+    double start = now_seconds();
+    for (int first = 0; first < num_codewords; first += CLIENT_WINDOW) {
+        int window = num_codewords - first < CLIENT_WINDOW ? num_codewords - first : CLIENT_WINDOW;
+
+        // Messages are written straight into the shared slots and encoded in place
+        for (int k = 0; k < window; k++) {
+            while ((slots[k] = service_acquire(client)) < 0) {
+                usleep(100);
+            }
+            uint8_t *payload = service_payload(client, slots[k]);
+            for (int j = SERVICE_PARITY_LEN; j < SERVICE_CODEWORD_LEN; j++) {
+                payload[j] = rand() & 0xFF;
+            }
+            if (service_submit(client, slots[k], SERVICE_OP_ENCODE) != 0) {
+                return stop_client(client);
+            }
+        }
+        for (int k = 0; k < window; k++) {
+            if (service_wait(client, slots[k]) == SERVICE_ERROR) return stop_client(client);
+            uint8_t *payload = service_payload(client, slots[k]);
+            memcpy(sent[k], payload, SERVICE_CODEWORD_LEN);
+
+            for (int e = 0; e < errors_per_codeword; e++) {
+                payload[rand() % SERVICE_CODEWORD_LEN] ^= 1 + rand() % 255;
+            }
+            if (service_submit(client, slots[k], SERVICE_OP_DECODE) != 0) {
+                return stop_client(client);
+            }
+        }
+        for (int k = 0; k < window; k++) {
+            int num_errors = service_wait(client, slots[k]);
+            int clean = service_call(client, slots[k], SERVICE_OP_CHECK);
+            if (num_errors == SERVICE_ERROR || clean == SERVICE_ERROR) return stop_client(client);
+            if (num_errors < 0 || !clean ||
+                memcmp(sent[k], service_payload(client, slots[k]), SERVICE_CODEWORD_LEN) != 0) {
+                failures++;
+            }
+            service_release(client, slots[k]);
+        }
+    }
+    double seconds = now_seconds() - start;
+
+    printf("%d codewords encoded, corrupted with %d errors and decoded in %.3f s (%.0f cw/s)\n",
+           num_codewords, errors_per_codeword, seconds, num_codewords / seconds);
+    printf("%d codewords failed to decode\n", failures);
+
+    service_disconnect(client);
+    return failures != 0;
+}
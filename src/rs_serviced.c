@@ -0,0 +1,305 @@
+/**
+ * Reed-Solomon Shared-Memory Codec Service, daemon
+ *
+ * Owns the GF tables and a pool of worker threads for every client process on the host. Workers
+ * pop up to BITSLICE_LANES jobs at a time from the shared job ring, so requests from different
+ * processes are pooled into batches: encode jobs go through the bit-sliced encoder, and the
+ * syndromes of check and decode jobs through the bit-sliced syndrome engine. A bit-sliced pass
+ * costs the same for 1 or 64 codewords, so small batches use rs_encode and the minimal polynomial
+ * syndrome engine instead. Only decode jobs with non-zero syndromes reach locate_errors, and they
+ * are corrected in place.
+ *
+ * Usage:
+ *  rs_serviced [-n shm name] [-t worker threads]
+ *
+ * On SIGINT or SIGTERM the service stops accepting jobs, the workers finish every job already in
+ * the ring, any job that slipped in after the workers exited is completed with SERVICE_ERROR, and
+ * the shared memory object is removed.
+ */
+#include "galois.h"
+#include "rs_bitslice.h"
+#include "rs_decoder.h"
+#include "rs_encoder.h"
+#include "rs_service.h"
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#define MAX_WORKERS 256
+
+// Smallest number of jobs worth a bit-sliced pass
+#define MIN_BITSLICE_BATCH 4
+
+static volatile sig_atomic_t stop_requested = 0;
+
+/**
+ * @brief Signal handler that asks the main thread to shut the service down
+ * @param signal_number Received signal
+ */
+static void request_stop(int signal_number) {
+    (void)signal_number;
+    stop_requested = 1;
+}
+
+/**
+ * @brief Marks a job as done and wakes the client waiting on it
+ * @param job Completed job
+ * @param result Result of the operation
+ */
+static void complete_job(service_slot *job, int32_t result) {
+    job->result = result;
+    atomic_store(&job->state, SLOT_DONE);
+    futex_wake(&job->state, INT_MAX);
+}
+
+/**
+ * @brief Runs a batch of encode jobs, through the bit-sliced encoder when the batch is large enough
+ * @param shm Shared memory segment
+ * @param batch Slot indices of the jobs
+ * @param count Number of jobs
+ */
+static void process_encode_batch(service_shm *shm, const uint32_t *batch, int count) {
+    if (count < MIN_BITSLICE_BATCH) {
+        for (int k = 0; k < count; k++) {
+            service_slot *job = &shm->slots[batch[k]];
+            uint8_t *encoded_message =
+                rs_encode(job->payload + SERVICE_PARITY_LEN, SERVICE_INFO_LEN);
+            memcpy(job->payload, encoded_message, SERVICE_PARITY_LEN);
+            free(encoded_message);
+            complete_job(job, 0);
+        }
+        return;
+    }
+
+    uint8_t info[BITSLICE_LANES * SERVICE_INFO_LEN];
+    uint8_t encoded[BITSLICE_LANES * SERVICE_CODEWORD_LEN];
+
+    for (int k = 0; k < count; k++) {
+        memcpy(info + k * SERVICE_INFO_LEN, shm->slots[batch[k]].payload + SERVICE_PARITY_LEN,
+               SERVICE_INFO_LEN);
+    }
+
+    bitslice_encode_batch(info, encoded, count);
+
+    for (int k = 0; k < count; k++) {
+        service_slot *job = &shm->slots[batch[k]];
+        memcpy(job->payload, encoded + k * SERVICE_CODEWORD_LEN, SERVICE_PARITY_LEN);
+        complete_job(job, 0);
+    }
+}
+
+/**
+ * @brief Runs a batch of check and decode jobs on their payloads in place, computing the syndromes
+ * with the bit-sliced engine when the batch is large enough
+ * @param shm Shared memory segment
+ * @param batch Slot indices of the jobs
+ * @param count Number of jobs
+ */
+static void process_codeword_batch(service_shm *shm, const uint32_t *batch, int count) {
+    uint8_t syndromes[BITSLICE_LANES * SERVICE_PARITY_LEN];
+    uint8_t error_vector[SERVICE_CODEWORD_LEN];
+
+    if (count < MIN_BITSLICE_BATCH) {
+        for (int k = 0; k < count; k++) {
+            compute_syndromes(shm->slots[batch[k]].payload, SERVICE_CODEWORD_LEN,
+                              syndromes + k * SERVICE_PARITY_LEN);
+        }
+    } else {
+        uint8_t received[BITSLICE_LANES * SERVICE_CODEWORD_LEN];
+        for (int k = 0; k < count; k++) {
+            memcpy(received + k * SERVICE_CODEWORD_LEN, shm->slots[batch[k]].payload,
+                   SERVICE_CODEWORD_LEN);
+        }
+        bitslice_syndromes_batch(received, syndromes, count);
+    }
+
+    for (int k = 0; k < count; k++) {
+        service_slot *job = &shm->slots[batch[k]];
+        const uint8_t *lane_syndromes = syndromes + k * SERVICE_PARITY_LEN;
+
+        int errors_detected = 0;
+        for (int i = 0; i < SERVICE_PARITY_LEN; i++) {
+            errors_detected |= lane_syndromes[i] != 0;
+        }
+
+        if (job->op == SERVICE_OP_CHECK || !errors_detected) {
+            complete_job(job, job->op == SERVICE_OP_CHECK ? !errors_detected : 0);
+            continue;
+        }
+
+        memset(error_vector, 0, sizeof(error_vector));
+        int num_errors = locate_errors(lane_syndromes, error_vector, SERVICE_CODEWORD_LEN);
+        if (num_errors >= 0) {
+            for (int j = 0; j < SERVICE_CODEWORD_LEN; j++) {
+                job->payload[j] = gf_add(job->payload[j], error_vector[j]);
+            }
+        }
+        complete_job(job, num_errors);
+    }
+}
+
+/**
+ * @brief Worker thread, pops jobs in batches until the service shuts down and the ring is empty
+ * @param arg Pointer to the shared memory segment
+ * @return NULL
+ */
+static void *run_worker(void *arg) {
+    service_shm *shm = arg;
+    uint32_t batch[BITSLICE_LANES];
+    uint32_t encode_batch[BITSLICE_LANES];
+    uint32_t codeword_batch[BITSLICE_LANES];
+
+    for (;;) {
+        int count = 0;
+        while (count < BITSLICE_LANES && ring_pop(&shm->jobs, &batch[count])) {
+            count++;
+        }
+
+        if (count == 0) {
+            // Jobs submitted before the shutdown flag was set have all been popped by now
+            if (atomic_load(&shm->shutdown) != SERVICE_RUNNING) break;
+
+            // Read the doorbell before the last check of the ring, so a job submitted in between
+            // changes the futex word and futex_wait returns straight away
+            uint32_t doorbell = atomic_load(&shm->doorbell);
+            atomic_fetch_add(&shm->sleepers, 1);
+            if (ring_pop(&shm->jobs, &batch[0])) {
+                count = 1;
+            } else if (atomic_load(&shm->shutdown) == SERVICE_RUNNING) {
+                futex_wait(&shm->doorbell, doorbell, NULL);
+            }
+            atomic_fetch_sub(&shm->sleepers, 1);
+            if (count == 0) continue;
+        }
+
+        // Slot indices and ops are written by clients, so anything out of range is not trusted
+        int num_encode = 0;
+        int num_codeword = 0;
+        for (int k = 0; k < count; k++) {
+            if (batch[k] >= SERVICE_SLOTS) continue;
+
+            int32_t op = shm->slots[batch[k]].op;
+            if (op == SERVICE_OP_ENCODE) {
+                encode_batch[num_encode++] = batch[k];
+            } else if (op == SERVICE_OP_CHECK || op == SERVICE_OP_DECODE) {
+                codeword_batch[num_codeword++] = batch[k];
+            } else {
+                complete_job(&shm->slots[batch[k]], SERVICE_ERROR);
+            }
+        }
+
+        if (num_encode > 0) process_encode_batch(shm, encode_batch, num_encode);
+        if (num_codeword > 0) process_codeword_batch(shm, codeword_batch, num_codeword);
+    }
+
+    return NULL;
+}
+
+int main(int argc, char **argv) {
+    const char *name = SERVICE_DEFAULT_NAME;
+    long num_workers = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "n:t:h")) != -1) {
+        switch (opt) {
+        case 'n': name = optarg; break;
+        case 't': num_workers = strtol(optarg, NULL, 10); break;
+        default:
+            printf("Usage: %s [-n shm name] [-t worker threads]\n", argv[0]);
+            return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (num_workers < 1) num_workers = 1;
+    if (num_workers > MAX_WORKERS) num_workers = MAX_WORKERS;
+
+    initialise_gf();
+    set_decoder_verbose(0);
+    set_syndrome_engine(SYNDROME_MINIMAL_POLY);
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        perror("shm_open");
+        fprintf(stderr, "Is another rs_serviced running? Remove /dev/shm%s if not\n", name);
+        return 1;
+    }
+    if (ftruncate(fd, sizeof(service_shm)) != 0) {
+        perror("ftruncate");
+        shm_unlink(name);
+        return 1;
+    }
+
+    service_shm *shm = mmap(NULL, sizeof(service_shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (shm == MAP_FAILED) {
+        perror("mmap");
+        shm_unlink(name);
+        return 1;
+    }
+
+    ring_init(&shm->free_slots, 1);
+    ring_init(&shm->jobs, 0);
+    for (int i = 0; i < SERVICE_SLOTS; i++) {
+        atomic_store(&shm->slots[i].state, SLOT_FREE);
+    }
+    atomic_store(&shm->shutdown, SERVICE_RUNNING);
+    atomic_store(&shm->doorbell, 0);
+    atomic_store(&shm->sleepers, 0);
+    atomic_store(&shm->daemon_pid, (uint32_t)getpid());
+    atomic_store(&shm->magic, SERVICE_MAGIC);
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = request_stop;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    pthread_t workers[MAX_WORKERS];
+    long num_started = 0;
+    while (num_started < num_workers &&
+           pthread_create(&workers[num_started], NULL, run_worker, shm) == 0) {
+        num_started++;
+    }
+    if (num_started == 0) {
+        fprintf(stderr, "Could not start any worker threads\n");
+        shm_unlink(name);
+        return 1;
+    }
+    num_workers = num_started;
+
+    printf("Codec service running on %s with %ld workers\n", name, num_workers);
+    fflush(stdout);
+
+    while (!stop_requested) {
+        pause();
+    }
+
+    printf("Shutting down codec service\n");
+    atomic_store(&shm->shutdown, SERVICE_DRAINING);
+    atomic_fetch_add(&shm->doorbell, 1);
+    futex_wake(&shm->doorbell, INT_MAX);
+    for (long t = 0; t < num_workers; t++) {
+        pthread_join(workers[t], NULL);
+    }
+
+    // A client that saw SERVICE_RUNNING just before the flag changed can still push a job after
+    // the workers left. Fail those, and clients see SERVICE_STOPPED for any pushed even later.
+    atomic_store(&shm->shutdown, SERVICE_STOPPED);
+    uint32_t slot;
+    while (ring_pop(&shm->jobs, &slot)) {
+        if (slot < SERVICE_SLOTS) complete_job(&shm->slots[slot], SERVICE_ERROR);
+    }
+
+    shm_unlink(name);
+    munmap(shm, sizeof(service_shm));
+    close(fd);
+    free(global_tables.antilog_table);
+    free(global_tables.log_table);
+    return 0;
+}
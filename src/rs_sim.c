@@ -0,0 +1,499 @@
+/**
+ * Reed-Solomon Monte Carlo Channel Simulator
+ *
+ * Measures decoder outcome rates for RS(223,255) over a sweep of symbol error probabilities. Every
+ * worker thread draws random messages from its own xoshiro256** generator, encodes them in batches
+ * with the bit-sliced encoder, passes them through the selected channel model and decodes them
+ * silently. Codewords the channel left untouched are counted as clean without running the decoder,
+ * since the syndromes of a valid codeword are zero by construction.
+ *
+ * Channel models:
+ *  iid:     every symbol is replaced by a different random value with probability p
+ *  ge:      Gilbert-Elliott bursts, errors only occur in the bad state with probability -e, bursts
+ *           last -b symbols on average and the long-run symbol error rate is p
+ *  erasure: every symbol is erased (set to 0) with probability p. The receiver knows the erased
+ *           positions and passes them to the errors-and-erasures decoder, which corrects up to 32
+ *           erasures per codeword
+ *
+ * Outcomes:
+ *  clean:         no symbol was changed or erased by the channel
+ *  corrected:     the decoder recovered the transmitted codeword
+ *  uncorrectable: the decoder reported that the errors could not be corrected
+ *  miscorrected:  the decoder returned a different codeword without reporting a failure
+ *
+ * Usage:
+ *  rs_sim [-m iid|ge|erasure] [-p p1,p2,...] [-n codewords] [-t threads] [-s seed]
+ *         [-b burst length] [-e bad state error probability] [-o output.csv]
+ */
+#include "galois.h"
+#include "rs_bitslice.h"
+#include "rs_decoder.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define MAX_POINTS 64
+#define MAX_THREADS 256
+
+typedef enum { CHANNEL_IID, CHANNEL_GILBERT_ELLIOTT, CHANNEL_ERASURE } channel_model;
+
+typedef struct {
+    uint64_t s[4];
+} rng_state;
+
+typedef struct {
+    channel_model model;
+    double symbol_error_prob;
+    double burst_len;
+    double bad_error_prob;
+} channel_params;
+
+typedef struct {
+    uint64_t clean;
+    uint64_t corrected;
+    uint64_t uncorrectable;
+    uint64_t miscorrected;
+} outcome_counts;
+
+typedef struct {
+    channel_params channel;
+    uint64_t num_codewords;
+    uint64_t seed;
+    outcome_counts counts;
+} sim_job;
+
+/**
+ * @brief splitmix64 step, used to expand a seed into the xoshiro256** state
+ * @param x Running splitmix64 state
+ * @return Next 64 bit output
+ */
+static uint64_t splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * @brief Seeds a xoshiro256** generator
+ * @param rng Generator to seed
+ * @param seed Seed value
+ */
+static void rng_seed(rng_state *rng, uint64_t seed) {
+    for (int i = 0; i < 4; i++) {
+        rng->s[i] = splitmix64(&seed);
+    }
+}
+
+static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+/**
+ * @brief xoshiro256** step
+ * @param rng Generator state
+ * @return Next 64 bit output
+ */
+static uint64_t rng_next(rng_state *rng) {
+    uint64_t *s = rng->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+/**
+ * @brief Draws a uniform double in (0, 1]
+ * @param rng Generator state
+ * @return Uniform random value, never 0 so that its logarithm is finite
+ */
+static double rng_uniform(rng_state *rng) { return ((rng_next(rng) >> 11) + 1) * 0x1.0p-53; }
+
+/**
+ * @brief Converts a probability into a threshold for comparing against rng_next
+ * @param p Probability between 0 and 1
+ * @return Threshold t such that rng_next(rng) < t has probability p
+ */
+static uint64_t probability_threshold(double p) {
+    if (p <= 0) return 0;
+    if (p >= 1) return UINT64_MAX;
+    return (uint64_t)(p * 18446744073709551616.0);
+}
+
+/**
+ * @brief Draws the number of symbols before the next event of a Bernoulli process
+ * @param rng Generator state
+ * @param log_miss log(1 - p) of the per-symbol event probability p
+ * @return Number of symbols without an event
+ */
+static int geometric_skip(rng_state *rng, double log_miss) {
+    if (log_miss == 0) return FIELD_SIZE;
+    double skip = floor(log(rng_uniform(rng)) / log_miss);
+    return skip > FIELD_SIZE ? FIELD_SIZE : (int)skip;
+}
+
+/**
+ * @brief Passes a codeword through the channel
+ * @param rng Generator state
+ * @param channel Channel model and parameters
+ * @param bad_state Gilbert-Elliott state, kept between codewords so bursts can cross them
+ * @param codeword Codeword to corrupt in place
+ * @param erasures Output array of FIELD_SIZE entries for the erased positions
+ * @param num_erasures Output parameter for the number of erased positions
+ * @return Number of symbols changed or erased by the channel
+ */
+static int apply_channel(rng_state *rng, const channel_params *channel, int *bad_state,
+                         uint8_t *codeword, int *erasures, int *num_erasures) {
+    int num_changed = 0;
+    *num_erasures = 0;
+
+    if (channel->model == CHANNEL_GILBERT_ELLIOTT) {
+        // Choose the transitions so that bad-state symbols make up p / e of the stream
+        double bad_fraction = channel->symbol_error_prob / channel->bad_error_prob;
+        double bad_to_good = 1.0 / channel->burst_len;
+        double good_to_bad = bad_fraction * bad_to_good / (1.0 - bad_fraction);
+        uint64_t bad_to_good_threshold = probability_threshold(bad_to_good);
+        uint64_t good_to_bad_threshold = probability_threshold(good_to_bad);
+        uint64_t error_threshold = probability_threshold(channel->bad_error_prob);
+
+        for (int j = 0; j < FIELD_SIZE; j++) {
+            if (*bad_state) {
+                if (rng_next(rng) < error_threshold) {
+                    codeword[j] ^= 1 + rng_next(rng) % 255;
+                    num_changed++;
+                }
+                if (rng_next(rng) < bad_to_good_threshold) *bad_state = 0;
+            } else if (rng_next(rng) < good_to_bad_threshold) {
+                *bad_state = 1;
+            }
+        }
+        return num_changed;
+    }
+
+    if (channel->symbol_error_prob <= 0) return 0;
+
+    double log_miss = log1p(-channel->symbol_error_prob);
+    for (int j = geometric_skip(rng, log_miss); j < FIELD_SIZE;
+         j += 1 + geometric_skip(rng, log_miss)) {
+        if (channel->model == CHANNEL_ERASURE) {
+            erasures[(*num_erasures)++] = j;
+            codeword[j] = 0;
+        } else {
+            codeword[j] ^= 1 + rng_next(rng) % 255;
+            num_changed++;
+        }
+    }
+    return num_changed + *num_erasures;
+}
+
+/**
+ * @brief Decodes a received codeword silently and classifies the outcome
+ * @param sent Transmitted codeword
+ * @param received Received codeword, corrected in place
+ * @param erasures Positions the channel marked as erased
+ * @param num_erasures Number of erased positions, 0 for the error channels
+ * @param counts Outcome counters to update
+ */
+static void classify_decode(const uint8_t *sent, uint8_t *received, const int *erasures,
+                            int num_erasures, outcome_counts *counts) {
+    uint8_t syndromes[NUM_SYNDROMES];
+    uint8_t error_vector[FIELD_SIZE];
+    memset(error_vector, 0, sizeof(error_vector));
+
+    // More erasures than parity symbols cannot be filled in, whatever the syndromes are
+    if (num_erasures > NUM_SYNDROMES) {
+        counts->uncorrectable++;
+        return;
+    }
+
+    // Zero syndromes mean the received word is a codeword: the sent one if every erased symbol
+    // happened to be 0, otherwise the channel turned it into another valid codeword
+    int errors_detected = compute_syndromes(received, FIELD_SIZE, syndromes);
+    int num_corrected = 0;
+    if (errors_detected && num_erasures > 0) {
+        num_corrected = locate_errors_and_erasures(syndromes, erasures, num_erasures,
+                                                   error_vector, FIELD_SIZE);
+    } else if (errors_detected) {
+        num_corrected = locate_errors(syndromes, error_vector, FIELD_SIZE);
+    }
+
+    if (num_corrected < 0) {
+        counts->uncorrectable++;
+        return;
+    }
+
+    for (int j = 0; j < FIELD_SIZE; j++) {
+        received[j] = gf_add(received[j], error_vector[j]);
+    }
+
+    if (memcmp(sent, received, FIELD_SIZE) == 0) {
+        counts->corrected++;
+    } else {
+        counts->miscorrected++;
+    }
+}
+
+/**
+ * @brief Worker thread, simulates job->num_codewords codewords
+ * @param arg Pointer to the sim_job of this thread
+ * @return NULL
+ */
+static void *run_job(void *arg) {
+    sim_job *job = arg;
+    int info_len = FIELD_SIZE - NUM_SYNDROMES;
+    uint8_t info[BITSLICE_LANES * (FIELD_SIZE - NUM_SYNDROMES)];
+    uint8_t encoded[BITSLICE_LANES * FIELD_SIZE];
+    uint8_t received[FIELD_SIZE];
+    int erasures[FIELD_SIZE];
+    int num_erasures;
+    rng_state rng;
+    int bad_state = 0;
+
+    rng_seed(&rng, job->seed);
+    memset(&job->counts, 0, sizeof(job->counts));
+
+    for (uint64_t done = 0; done < job->num_codewords; done += BITSLICE_LANES) {
+        int lanes = BITSLICE_LANES;
+        if (job->num_codewords - done < (uint64_t)lanes) lanes = job->num_codewords - done;
+
+        for (int i = 0; i < lanes * info_len; i += 8) {
+            uint64_t bits = rng_next(&rng);
+            int chunk = lanes * info_len - i < 8 ? lanes * info_len - i : 8;
+            memcpy(info + i, &bits, chunk);
+        }
+        bitslice_encode_batch(info, encoded, lanes);
+
+        for (int lane = 0; lane < lanes; lane++) {
+            const uint8_t *sent = encoded + lane * FIELD_SIZE;
+            memcpy(received, sent, FIELD_SIZE);
+
+            if (apply_channel(&rng, &job->channel, &bad_state, received, erasures,
+                              &num_erasures) == 0) {
+                job->counts.clean++;
+            } else {
+                classify_decode(sent, received, erasures, num_erasures, &job->counts);
+            }
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Calculates the 95% Wilson score interval of a binomial proportion
+ * @param successes Number of successes
+ * @param trials Number of trials
+ * @param low Output lower bound
+ * @param high Output upper bound
+ */
+static void wilson_interval(uint64_t successes, uint64_t trials, double *low, double *high) {
+    const double z = 1.959963984540054;
+    double n = (double)trials;
+    double p_hat = successes / n;
+    double denominator = 1 + z * z / n;
+    double center = (p_hat + z * z / (2 * n)) / denominator;
+    double half_width = z * sqrt(p_hat * (1 - p_hat) / n + z * z / (4 * n * n)) / denominator;
+
+    *low = center - half_width < 0 ? 0 : center - half_width;
+    *high = center + half_width > 1 ? 1 : center + half_width;
+}
+
+/**
+ * @brief Writes a rate and its confidence interval as three CSV columns
+ * @param out Output file
+ * @param count Number of codewords with the outcome
+ * @param total Number of simulated codewords
+ */
+static void write_rate(FILE *out, uint64_t count, uint64_t total) {
+    double low, high;
+    wilson_interval(count, total, &low, &high);
+    fprintf(out, ",%.6e,%.6e,%.6e", (double)count / total, low, high);
+}
+
+/**
+ * @brief Prints the command line options
+ * @param program Name of the executable
+ */
+static void print_usage(const char *program) {
+    printf("Usage: %s [options]\n", program);
+    printf("  -m MODEL   channel model: iid, ge or erasure (default iid)\n");
+    printf("  -p LIST    comma separated symbol error probabilities (default 0.01,0.03,0.05)\n");
+    printf("  -n COUNT   codewords per probability (default 1000000)\n");
+    printf("  -t COUNT   worker threads (default: number of online CPUs)\n");
+    printf("  -s SEED    random seed (default 1)\n");
+    printf("  -b LENGTH  ge: mean burst length in symbols (default 8)\n");
+    printf("  -e PROB    ge: symbol error probability in the bad state (default 0.5)\n");
+    printf("  -o FILE    CSV output file (default sim_results.csv)\n");
+}
+
+int main(int argc, char **argv) {
+    channel_params channel = {CHANNEL_IID, 0, 8.0, 0.5};
+    const char *model_name = "iid";
+    const char *output_path = "sim_results.csv";
+    char default_probs[] = "0.01,0.03,0.05";
+    char *prob_list = default_probs;
+    uint64_t num_codewords = 1000000;
+    uint64_t seed = 1;
+    long num_threads = sysconf(_SC_NPROCESSORS_ONLN);
+    int opt;
+
+    while ((opt = getopt(argc, argv, "m:p:n:t:s:b:e:o:h")) != -1) {
+        switch (opt) {
+        case 'm':
+            model_name = optarg;
+            if (strcmp(optarg, "iid") == 0) {
+                channel.model = CHANNEL_IID;
+            } else if (strcmp(optarg, "ge") == 0) {
+                channel.model = CHANNEL_GILBERT_ELLIOTT;
+            } else if (strcmp(optarg, "erasure") == 0) {
+                channel.model = CHANNEL_ERASURE;
+            } else {
+                fprintf(stderr, "Unknown channel model '%s'\n", optarg);
+                return 1;
+            }
+            break;
+        case 'p': prob_list = optarg; break;
+        case 'n': num_codewords = strtoull(optarg, NULL, 10); break;
+        case 't': num_threads = strtol(optarg, NULL, 10); break;
+        case 's': seed = strtoull(optarg, NULL, 10); break;
+        case 'b': channel.burst_len = strtod(optarg, NULL); break;
+        case 'e': channel.bad_error_prob = strtod(optarg, NULL); break;
+        case 'o': output_path = optarg; break;
+        default: print_usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+
+    double probs[MAX_POINTS];
+    int num_points = 0;
+    for (char *token = strtok(prob_list, ","); token && num_points < MAX_POINTS;
+         token = strtok(NULL, ",")) {
+        char *end;
+        double prob = strtod(token, &end);
+        // Written so that NaN fails the range check as well
+        if (end == token || *end != '\0' || !(prob >= 0 && prob <= 1)) {
+            fprintf(stderr, "Symbol error probability '%s' is not between 0 and 1\n", token);
+            return 1;
+        }
+        probs[num_points++] = prob;
+    }
+
+    if (num_points == 0 || num_codewords == 0) {
+        print_usage(argv[0]);
+        return 1;
+    }
+    if (num_threads < 1) num_threads = 1;
+    if (num_threads > MAX_THREADS) num_threads = MAX_THREADS;
+    if (channel.model == CHANNEL_GILBERT_ELLIOTT && !(channel.burst_len >= 1)) {
+        fprintf(stderr, "Burst length must be at least 1\n");
+        return 1;
+    }
+    if (channel.model == CHANNEL_GILBERT_ELLIOTT &&
+        !(channel.bad_error_prob > 0 && channel.bad_error_prob <= 1)) {
+        fprintf(stderr, "Bad state error probability must be in (0, 1]\n");
+        return 1;
+    }
+
+    FILE *out = fopen(output_path, "w");
+    if (!out) {
+        perror(output_path);
+        return 1;
+    }
+
+    initialise_gf();
+    set_decoder_verbose(0);
+    set_syndrome_engine(SYNDROME_MINIMAL_POLY);
+
+    fprintf(out, "model,symbol_error_prob,codewords");
+    const char *outcome_names[] = {"clean", "corrected", "uncorrectable", "miscorrected",
+                                   "block_error"};
+    for (int k = 0; k < 5; k++) {
+        fprintf(out, ",%s_rate,%s_low,%s_high", outcome_names[k], outcome_names[k],
+                outcome_names[k]);
+    }
+    fprintf(out, "\n");
+
+    printf("Simulating %llu codewords per point on %ld threads, channel model %s\n\n",
+           (unsigned long long)num_codewords, num_threads, model_name);
+    printf("%-10s | %-10s | %-10s | %-13s | %-12s | %-34s | %s\n", "p", "clean", "corrected",
+           "uncorrectable", "miscorrected", "block error rate [95% CI]", "cw/s");
+
+    sim_job jobs[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    int thread_started[MAX_THREADS];
+
+    for (int point = 0; point < num_points; point++) {
+        channel.symbol_error_prob = probs[point];
+        if (channel.model == CHANNEL_GILBERT_ELLIOTT &&
+            channel.symbol_error_prob >= channel.bad_error_prob) {
+            fprintf(stderr, "ge: p=%g must be below the bad state error probability %g\n",
+                    channel.symbol_error_prob, channel.bad_error_prob);
+            continue;
+        }
+
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+
+        for (long t = 0; t < num_threads; t++) {
+            jobs[t].channel = channel;
+            jobs[t].num_codewords = num_codewords / num_threads;
+            if ((uint64_t)t < num_codewords % num_threads) jobs[t].num_codewords++;
+            jobs[t].seed = seed * 0x100000001B3ULL + point * MAX_THREADS + t;
+            thread_started[t] = pthread_create(&threads[t], NULL, run_job, &jobs[t]) == 0;
+            if (!thread_started[t]) {
+                // Keep the results complete by running the share on the main thread instead
+                fprintf(stderr, "pthread_create failed, running job %ld inline\n", t);
+                run_job(&jobs[t]);
+            }
+        }
+
+        outcome_counts total = {0};
+        for (long t = 0; t < num_threads; t++) {
+            if (thread_started[t]) pthread_join(threads[t], NULL);
+            total.clean += jobs[t].counts.clean;
+            total.corrected += jobs[t].counts.corrected;
+            total.uncorrectable += jobs[t].counts.uncorrectable;
+            total.miscorrected += jobs[t].counts.miscorrected;
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double seconds = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) * 1e-9;
+
+        uint64_t block_errors = total.uncorrectable + total.miscorrected;
+        double low, high;
+        wilson_interval(block_errors, num_codewords, &low, &high);
+
+        printf("%-10g | %-10.4e | %-10.4e | %-13.4e | %-12.4e | %.4e [%.4e, %.4e] | %.0f\n",
+               channel.symbol_error_prob, (double)total.clean / num_codewords,
+               (double)total.corrected / num_codewords,
+               (double)total.uncorrectable / num_codewords,
+               (double)total.miscorrected / num_codewords, (double)block_errors / num_codewords,
+               low, high, num_codewords / seconds);
+
+        fprintf(out, "%s,%g,%llu", model_name, channel.symbol_error_prob,
+                (unsigned long long)num_codewords);
+        write_rate(out, total.clean, num_codewords);
+        write_rate(out, total.corrected, num_codewords);
+        write_rate(out, total.uncorrectable, num_codewords);
+        write_rate(out, total.miscorrected, num_codewords);
+        write_rate(out, block_errors, num_codewords);
+        fprintf(out, "\n");
+        fflush(out);
+    }
+
+    fclose(out);
+    printf("\nResults written to %s\n", output_path);
+
+    free(global_tables.antilog_table);
+    free(global_tables.log_table);
+    return 0;
+}